@@ -0,0 +1,46 @@
+#ifndef BREADTH_FIRST_TREE_H
+#define BREADTH_FIRST_TREE_H
+
+#include <vector> // For the vector class
+#include <algorithm> // For the reverse function
+#include "Edge.h" // For the NodeID type
+
+// BreadthFirstTree
+// This holds the result of a breadth first search, the amount of hops from
+// the source to every node and the node before it on a shortest hop path.
+// Nodes that were not reached have a level and a parent of -1.
+struct BreadthFirstTree {
+	NodeID source;               // The node the search started from
+	std::vector<int> levels;     // The amount of hops from the source to every node
+	std::vector<NodeID> parents; // The node before every node on its path, -1 if there is none
+	
+	// Reached
+	// params:
+	//	node: This is the node we are looking for
+	// Returns true if the search found a path to the node
+	bool Reached(NodeID node) const {
+		return (node >= 0 && node < (NodeID)levels.size() && levels[node] != -1);
+	}
+	
+	// GetPath
+	// params:
+	//	target: This is the node the path ends at
+	// Returns the nodes on the path from the source to the target, empty
+	// if the target was not reached
+	std::vector<NodeID> GetPath(NodeID target) const {
+		std::vector<NodeID> path;
+		
+		if (Reached(target)) {
+			// Walk back from the target to the source
+			for (NodeID node = target; node != -1; node = parents[node]) {
+				path.push_back(node);
+			}
+			
+			std::reverse(path.begin(), path.end());
+		}
+		
+		return path;
+	}
+};
+
+#endif
@@ -0,0 +1,150 @@
+#include "Parallel.h"
+#include "ConcurrentUnionFind.h"
+
+// Default Constructor
+// params:
+//	size: This is the total size of elements that will be watched
+// Creates a ConcurrentUnionFind for (size) elements
+ConcurrentUnionFind::ConcurrentUnionFind(NodeID size) {
+	Reset(size);
+	return;
+}
+
+// Copy Constructor
+// params:
+//	other: This is the structure to copy, it must not be changing
+ConcurrentUnionFind::ConcurrentUnionFind(const ConcurrentUnionFind & other) {
+	*this = other;
+	return;
+}
+
+// Assignment Operator
+// params:
+//	other: This is the structure to copy, it must not be changing
+ConcurrentUnionFind & ConcurrentUnionFind::operator=(const ConcurrentUnionFind & other) {
+	if (this != &other) {
+		// Atomics can not be copied so make room and copy every value
+		std::vector<std::atomic<NodeID> >(other.parents.size()).swap(parents);
+		
+		for (NodeID i = 0; i < parents.size(); i++) {
+			parents[i].store(other.parents[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+	}
+	
+	return *this;
+}
+
+// Reset
+// params:
+//	size: This is the total size of elements that will be watched
+//	threads: This is the amount of threads to use, 0 uses every core
+// Puts every one of (size) elements back into its own set. This must
+// not run at the same time as anything else.
+void ConcurrentUnionFind::Reset(NodeID size, int threads) {
+	// Atomics can not be resized so make a fresh array if the size changed
+	if (parents.size() != size) {
+		std::vector<std::atomic<NodeID> >(size).swap(parents);
+	}
+	
+	// Set every elements parent to itself
+	ParallelFor(0, size, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			parents[i].store(i, std::memory_order_relaxed);
+		}
+	}, threads);
+	
+	return;
+}
+
+// Union
+// params:
+//	one: This is an element in the first set to merge
+//	two: This is an element in the second set to merge
+// Merges the two sets, returns true if this call merged them
+bool ConcurrentUnionFind::Union(NodeID one, NodeID two) {
+	// Keep trying until the sets are the same or this call links them
+	while (true) {
+		one = Find(one);
+		two = Find(two);
+		
+		// If the elements are already in the same set
+		if (one == two) {
+			return false;
+		}
+		
+		// Always link the bigger root under the smaller one
+		if (one < two) {
+			NodeID temp = one;
+			one = two;
+			two = temp;
+		}
+		
+		// If the bigger root is still a root link it, otherwise another
+		// thread got to it first and we go again from its new root
+		NodeID expected = one;
+		if (parents[one].compare_exchange_strong(expected, two)) {
+			return true;
+		}
+	}
+}
+
+// Find
+// params:
+//	one: This is the element we are looking to find
+// Returns the root of the set that this element is in, which is the
+// smallest element of the set
+NodeID ConcurrentUnionFind::Find(NodeID one) {
+	NodeID parent = parents[one].load(std::memory_order_relaxed);
+	
+	// While the element is not a root
+	while (parent != one) {
+		NodeID grandparent = parents[parent].load(std::memory_order_relaxed);
+		
+		// Point the element at its grandparent, if another thread already
+		// moved it the path only got shorter so the failure does not matter
+		if (parent != grandparent) {
+			parents[one].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+		}
+		
+		one = grandparent;
+		parent = parents[one].load(std::memory_order_relaxed);
+	}
+	
+	return one;
+}
+
+// SameSet
+// params:
+//	one: This is the first element
+//	two: This is the second element
+// Returns true if both elements are in the same set
+bool ConcurrentUnionFind::SameSet(NodeID one, NodeID two) {
+	// Keep trying until the answer can not be changed by another thread
+	while (true) {
+		one = Find(one);
+		two = Find(two);
+		
+		if (one == two) {
+			return true;
+		}
+		
+		// If the first root is still a root the sets really are different
+		if (parents[one].load() == one) {
+			return false;
+		}
+	}
+}
+
+// GetParent
+// params:
+//	one: This is the element whose parent we want
+// Returns the current parent of the element without walking up to the root
+NodeID ConcurrentUnionFind::GetParent(NodeID one) const {
+	return parents[one].load(std::memory_order_relaxed);
+}
+
+// GetNumElements
+// Returns the amount of elements being watched
+NodeID ConcurrentUnionFind::GetNumElements() const {
+	return parents.size();
+}
@@ -0,0 +1,77 @@
+#ifndef CONCURRENT_UNION_FIND_H
+#define CONCURRENT_UNION_FIND_H
+
+#include <atomic> // For the atomic class
+#include <vector> // For the vector class
+#include "Edge.h" // For the NodeID type
+
+// ConcurrentUnionFind
+// This is a lock free UnionFind that any amount of threads can Union
+// and Find on at the same time. Every parent is an atomic that is only
+// ever moved to a smaller element with a compare and swap, a root is
+// always linked under the smaller of the two roots, and Find halves the
+// paths it walks. The root of every set is therefore its smallest
+// element, no matter the order the unions happened in. This is used
+// for the parallel MST and connected components algorithms.
+class ConcurrentUnionFind {
+	private:
+		std::vector<std::atomic<NodeID> > parents; // The parent of every element
+	
+	public:
+		// Default Constructor
+		// params:
+		//	size: This is the total size of elements that will be watched
+		// Creates a ConcurrentUnionFind for (size) elements
+		ConcurrentUnionFind(NodeID size = 0);
+		
+		// Copy Constructor
+		// params:
+		//	other: This is the structure to copy, it must not be changing
+		ConcurrentUnionFind(const ConcurrentUnionFind & other);
+		
+		// Assignment Operator
+		// params:
+		//	other: This is the structure to copy, it must not be changing
+		ConcurrentUnionFind & operator=(const ConcurrentUnionFind & other);
+		
+		// Reset
+		// params:
+		//	size: This is the total size of elements that will be watched
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Puts every one of (size) elements back into its own set. This must
+		// not run at the same time as anything else.
+		void Reset(NodeID size, int threads = 0);
+		
+		// Union
+		// params:
+		//	one: This is an element in the first set to merge
+		//	two: This is an element in the second set to merge
+		// Merges the two sets, returns true if this call merged them
+		bool Union(NodeID one, NodeID two);
+		
+		// Find
+		// params:
+		//	one: This is the element we are looking to find
+		// Returns the root of the set that this element is in, which is the
+		// smallest element of the set
+		NodeID Find(NodeID one);
+		
+		// SameSet
+		// params:
+		//	one: This is the first element
+		//	two: This is the second element
+		// Returns true if both elements are in the same set
+		bool SameSet(NodeID one, NodeID two);
+		
+		// GetParent
+		// params:
+		//	one: This is the element whose parent we want
+		// Returns the current parent of the element without walking up to the root
+		NodeID GetParent(NodeID one) const;
+		
+		// GetNumElements
+		// Returns the amount of elements being watched
+		NodeID GetNumElements() const;
+};
+
+#endif
@@ -0,0 +1,805 @@
+#include <fstream> // For writing hierarchy files
+#include <cstring> // For memcmp, memcpy and memset
+#include <limits> // For the numeric_limits class
+#include <atomic> // For the atomic class
+#include <algorithm> // For the fill function
+#include "Parallel.h"
+#include "ContractionHierarchy.h"
+
+// Default Constructor
+// Creates an empty hierarchy
+ContractionHierarchy::ContractionHierarchy() : vertices(0), upOffsets(1, 0), downOffsets(1, 0) {
+	return;
+}
+
+// AddArc
+// params:
+//	from: This is the node the arc leaves
+//	to: This is the node the arc goes to
+//	weight: This is the length of the arc
+//	middle: This is the node the arc skips, -1 if it is an edge
+// Adds the arc to the build graph, or shortens the arc already there
+void ContractionHierarchy::AddArc(NodeID from, NodeID to, Weight weight, NodeID middle) {
+	ArcList & out = outArcs[from], & in = inArcs[to];
+	Arc arc;
+	int i;
+	
+	// Clear the padding as well so saving the same hierarchy always
+	// writes the same bytes
+	memset(&arc, 0, sizeof(arc));
+	arc.target = to;
+	arc.weight = weight;
+	arc.middle = middle;
+	
+	// If the arc is already there only keep the shorter one
+	for (i = 0; i < out.size() && out[i].target != to; i++) {
+	}
+	
+	if (i < out.size()) {
+		if (weight < out[i].weight) {
+			out[i] = arc;
+			
+			for (i = 0; in[i].target != from; i++) {
+			}
+			
+			in[i].weight = weight;
+			in[i].middle = middle;
+		}
+	} else {
+		out.push_back(arc);
+		arc.target = from;
+		in.push_back(arc);
+	}
+	
+	return;
+}
+
+// WitnessSearch
+// params:
+//	source: This is the node the search starts from
+//	skip: This is the node being contracted, which is never entered
+//	limit: This is the distance past which the search stops
+//	maxSettled: This is the amount of nodes settled before the search gives up
+//	targets: This is the amount of nodes marked in witnessTargets
+// Runs a Dijkstra around the source that avoids the skipped node, filling
+// witnessDistances. Stops early once every marked node is settled.
+void ContractionHierarchy::WitnessSearch(NodeID source, NodeID skip, Weight limit, int maxSettled, int targets) {
+	int settled = 0;
+	NodeID node;
+	
+	// Forget the last search
+	for (int i = 0; i < witnessTouched.size(); i++) {
+		witnessDistances[witnessTouched[i]] = InfiniteWeight;
+	}
+	
+	witnessTouched.clear();
+	witnessHeap.Clear();
+	
+	witnessDistances[source] = 0;
+	witnessTouched.push_back(source);
+	witnessHeap.Push(source, 0);
+	
+	// While there are close enough nodes left and the search is still small
+	while (targets > 0 && !witnessHeap.Empty() && witnessHeap.GetKey(witnessHeap.Front()) <= limit && settled++ < maxSettled) {
+		node = witnessHeap.Pop();
+		
+		// The distance to a settled node is final
+		if (witnessTargets[node]) {
+			targets--;
+		}
+		
+		// For every neighbor to this node
+		for (int i = 0; i < outArcs[node].size(); i++) {
+			const Arc & arc = outArcs[node][i];
+			Weight through = witnessDistances[node] + arc.weight;
+			
+			// If going through this node is a shorter way to the neighbor
+			if (arc.target != skip && through < witnessDistances[arc.target]) {
+				if (witnessDistances[arc.target] == InfiniteWeight) {
+					witnessTouched.push_back(arc.target);
+				}
+				
+				witnessDistances[arc.target] = through;
+				witnessHeap.PushOrDecrease(arc.target, through);
+			}
+		}
+	}
+	
+	return;
+}
+
+// Contract
+// params:
+//	node: This is the node to contract
+//	simulate: Is a flag if the shortcuts should only be counted
+// Finds every shortcut needed to remove the node and returns how many
+// there are. Unless simulating the shortcuts are added and the node is
+// taken out of the build graph.
+int ContractionHierarchy::Contract(NodeID node, bool simulate) {
+	int shortcuts = 0, targets = 0;
+	
+	// Mark the nodes the witness searches have to reach
+	for (int j = 0; j < outArcs[node].size(); j++) {
+		witnessTargets[outArcs[node][j].target] = true;
+		targets++;
+	}
+	
+	// For every node with an arc into this one
+	for (int i = 0; i < inArcs[node].size(); i++) {
+		Arc in = inArcs[node][i];
+		Weight longest = 0;
+		
+		// Work out how far the witness search has to look
+		for (int j = 0; j < outArcs[node].size(); j++) {
+			if (outArcs[node][j].target != in.target && outArcs[node][j].weight > longest) {
+				longest = outArcs[node][j].weight;
+			}
+		}
+		
+		// Rating only needs a rough count, so simulated searches stay smaller
+		WitnessSearch(in.target, node, in.weight + longest, (simulate ? 50 : 500), targets);
+		
+		// Every path through this node with no witness as short needs a shortcut
+		for (int j = 0; j < outArcs[node].size(); j++) {
+			Arc out = outArcs[node][j];
+			
+			if (out.target != in.target && witnessDistances[out.target] > in.weight + out.weight) {
+				shortcuts++;
+				
+				if (!simulate) {
+					AddArc(in.target, out.target, in.weight + out.weight, node);
+				}
+			}
+		}
+	}
+	
+	for (int j = 0; j < outArcs[node].size(); j++) {
+		witnessTargets[outArcs[node][j].target] = false;
+	}
+	
+	if (!simulate) {
+		// Remove the arcs into this node from its neighbors
+		for (int i = 0; i < inArcs[node].size(); i++) {
+			ArcList & out = outArcs[inArcs[node][i].target];
+			
+			for (int j = 0; j < out.size(); j++) {
+				if (out[j].target == node) {
+					out[j] = out.back();
+					out.pop_back();
+					break;
+				}
+			}
+			
+			deletedNeighbors[inArcs[node][i].target]++;
+		}
+		
+		// Remove the arcs out of this node from its neighbors
+		for (int i = 0; i < outArcs[node].size(); i++) {
+			ArcList & in = inArcs[outArcs[node][i].target];
+			
+			for (int j = 0; j < in.size(); j++) {
+				if (in[j].target == node) {
+					in[j] = in.back();
+					in.pop_back();
+					break;
+				}
+			}
+			
+			deletedNeighbors[outArcs[node][i].target]++;
+		}
+	}
+	
+	return shortcuts;
+}
+
+// GetPriority
+// params:
+//	node: This is the node to rate
+// Returns the edge difference of the node, the shortcuts contracting it
+// would add less the arcs it would remove, plus its contracted neighbors
+// so the contraction spreads evenly over the graph
+float ContractionHierarchy::GetPriority(NodeID node) {
+	int removed = inArcs[node].size() + outArcs[node].size();
+	
+	return (float)(Contract(node, true) - removed + deletedNeighbors[node]);
+}
+
+// Build
+// params:
+//	graph: This is the graph to build the hierarchy for
+// Contracts every node of the graph and packs the upward arcs
+void ContractionHierarchy::Build(const CsrGraph & graph) {
+	std::vector<ArcList> up, down;
+	IndexedHeap<float> order;
+	NodeID node;
+	
+	vertices = graph.GetNumVertices();
+	outArcs.assign(vertices, ArcList());
+	inArcs.assign(vertices, ArcList());
+	up.assign(vertices, ArcList());
+	down.assign(vertices, ArcList());
+	deletedNeighbors.assign(vertices, 0);
+	witnessHeap.Resize(vertices);
+	witnessDistances.assign(vertices, InfiniteWeight);
+	witnessTouched.clear();
+	witnessTargets.assign(vertices, false);
+	
+	// Copy every edge into the build graph, self loops never help a path
+	for (NodeID i = 0; i < vertices; i++) {
+		for (EdgeIndex j = graph.GetBegin(i); j < graph.GetEnd(i); j++) {
+			if (graph.GetTarget(j) != i) {
+				AddArc(i, graph.GetTarget(j), graph.GetWeight(j), -1);
+			}
+		}
+	}
+	
+	// Rate every node
+	order.Resize(vertices);
+	for (NodeID i = 0; i < vertices; i++) {
+		order.Push(i, GetPriority(i));
+	}
+	
+	// Contract the least important node until none are left
+	while ((node = order.Pop()) != -1) {
+		float priority = GetPriority(node);
+		
+		// The rating goes stale as neighbors are contracted, so if the node
+		// is no longer the least important put it back
+		if (!order.Empty() && priority > order.GetKey(order.Front())) {
+			order.Push(node, priority);
+			continue;
+		}
+		
+		// Every neighbor left is more important, so the arcs to them are final
+		up[node] = outArcs[node];
+		down[node] = inArcs[node];
+		
+		Contract(node, false);
+		ArcList().swap(outArcs[node]);
+		ArcList().swap(inArcs[node]);
+	}
+	
+	// Pack the upward and downward arcs
+	upOffsets.assign(1, 0);
+	downOffsets.assign(1, 0);
+	upArcs.clear();
+	downArcs.clear();
+	
+	for (NodeID i = 0; i < vertices; i++) {
+		upArcs.insert(upArcs.end(), up[i].begin(), up[i].end());
+		downArcs.insert(downArcs.end(), down[i].begin(), down[i].end());
+		upOffsets.push_back(upArcs.size());
+		downOffsets.push_back(downArcs.size());
+	}
+	
+	// Release everything only the build needed
+	std::vector<ArcList>().swap(outArcs);
+	std::vector<ArcList>().swap(inArcs);
+	std::vector<int>().swap(deletedNeighbors);
+	std::vector<Weight>().swap(witnessDistances);
+	std::vector<NodeID>().swap(witnessTouched);
+	std::vector<bool>().swap(witnessTargets);
+	witnessHeap.Resize(0);
+	
+	PrepareQueries();
+	
+	return;
+}
+
+// PrepareSide
+// params:
+//	side: This is the workspace to size
+// Sizes a query workspace for the hierarchy
+void ContractionHierarchy::PrepareSide(Side & side) const {
+	side.heap.Resize(vertices);
+	side.distances.assign(vertices, InfiniteWeight);
+	side.parents.assign(vertices, -1);
+	side.middles.assign(vertices, -1);
+	side.touched.clear();
+	
+	return;
+}
+
+// PrepareQueries
+// Sizes the query workspaces for the hierarchy
+void ContractionHierarchy::PrepareQueries() {
+	PrepareSide(forward);
+	PrepareSide(backward);
+	
+	return;
+}
+
+// Reset
+// params:
+//	side: This is the workspace to reset
+// Puts every node the last query touched back to unreached
+void ContractionHierarchy::Reset(Side & side) {
+	for (int i = 0; i < side.touched.size(); i++) {
+		side.distances[side.touched[i]] = InfiniteWeight;
+		side.parents[side.touched[i]] = -1;
+	}
+	
+	side.touched.clear();
+	side.heap.Clear();
+	
+	return;
+}
+
+// SearchUp
+// params:
+//	side: This is the workspace to settle a node from
+//	other: This is the workspace of the search from the other end
+//	offsets: This is where the arcs of every node start
+//	arcs: This is the arcs this side follows
+//	best: This is the length of the shortest path found so far
+//	meet: This is the node the shortest path found so far goes through
+// Settles the closest node of the side and relaxes its upward arcs
+void ContractionHierarchy::SearchUp(Side & side, Side & other, const std::vector<EdgeIndex> & offsets, const std::vector<Arc> & arcs, Weight & best, NodeID & meet) {
+	NodeID node = side.heap.Pop();
+	Weight distance = side.distances[node];
+	
+	// If the other end reached this node too it joins a full path
+	if (other.distances[node] != InfiniteWeight && distance + other.distances[node] < best) {
+		best = distance + other.distances[node];
+		meet = node;
+	}
+	
+	// For every arc up from this node
+	for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+		const Arc & arc = arcs[j];
+		Weight through = distance + arc.weight;
+		
+		// If going through this node is a shorter way to the neighbor
+		if (through < side.distances[arc.target]) {
+			if (side.distances[arc.target] == InfiniteWeight) {
+				side.touched.push_back(arc.target);
+			}
+			
+			side.distances[arc.target] = through;
+			side.parents[arc.target] = node;
+			side.middles[arc.target] = arc.middle;
+			side.heap.PushOrDecrease(arc.target, through);
+		}
+	}
+	
+	return;
+}
+
+// SearchAll
+// params:
+//	side: This is the workspace to search with
+//	start: This is the node the search starts from
+//	offsets: This is where the arcs of every node start
+//	arcs: This is the arcs the search follows
+// Runs a full upward search from the node, every node it reaches is
+// left in the touched list of the side with its final distance
+void ContractionHierarchy::SearchAll(Side & side, NodeID start, const std::vector<EdgeIndex> & offsets, const std::vector<Arc> & arcs) {
+	NodeID node;
+	
+	Reset(side);
+	
+	side.distances[start] = 0;
+	side.touched.push_back(start);
+	side.heap.Push(start, 0);
+	
+	// While there are nodes left to settle
+	while ((node = side.heap.Pop()) != -1) {
+		Weight distance = side.distances[node];
+		
+		// For every arc up from this node
+		for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+			const Arc & arc = arcs[j];
+			Weight through = distance + arc.weight;
+			
+			// If going through this node is a shorter way to the neighbor
+			if (through < side.distances[arc.target]) {
+				if (side.distances[arc.target] == InfiniteWeight) {
+					side.touched.push_back(arc.target);
+				}
+				
+				side.distances[arc.target] = through;
+				side.heap.PushOrDecrease(arc.target, through);
+			}
+		}
+	}
+	
+	return;
+}
+
+// Unpack
+// params:
+//	from: This is the node the arc leaves
+//	to: This is the node the arc goes to
+//	middle: This is the node the arc skips, -1 if it is an edge
+//	path: This has every node the arc passes through after from added
+// Expands a shortcut back into the edges of the graph it stands for
+void ContractionHierarchy::Unpack(NodeID from, NodeID to, NodeID middle, std::vector<NodeID> & path) const {
+	// If this is an edge of the graph there is nothing to expand
+	if (middle == -1) {
+		path.push_back(to);
+		return;
+	}
+	
+	// The two halves were both arcs of the middle node when it was contracted
+	for (EdgeIndex j = downOffsets[middle]; j < downOffsets[middle + 1]; j++) {
+		if (downArcs[j].target == from) {
+			Unpack(from, middle, downArcs[j].middle, path);
+			break;
+		}
+	}
+	
+	for (EdgeIndex j = upOffsets[middle]; j < upOffsets[middle + 1]; j++) {
+		if (upArcs[j].target == to) {
+			Unpack(middle, to, upArcs[j].middle, path);
+			break;
+		}
+	}
+	
+	return;
+}
+
+// Query
+// params:
+//	source: This is the node the path starts at
+//	target: This is the node the path ends at
+//	path: This is filled with the nodes on the path if it is not NULL
+// Searches upward from both ends and returns the length of the shortest
+// path, infinite if there is none
+Weight ContractionHierarchy::Query(NodeID source, NodeID target, std::vector<NodeID> * path) {
+	Weight best = InfiniteWeight;
+	NodeID meet = -1;
+	
+	Reset(forward);
+	Reset(backward);
+	
+	if (path != NULL) {
+		path->clear();
+	}
+	
+	// If either end is not in the hierarchy there is no path
+	if (source < 0 || source >= vertices || target < 0 || target >= vertices) {
+		return best;
+	}
+	
+	forward.distances[source] = 0;
+	forward.touched.push_back(source);
+	forward.heap.Push(source, 0);
+	backward.distances[target] = 0;
+	backward.touched.push_back(target);
+	backward.heap.Push(target, 0);
+	
+	// While either side could still find a shorter path, the searches
+	// only go up so neither can stop when the other does
+	while (true) {
+		bool forwardOpen = !forward.heap.Empty() && forward.heap.GetKey(forward.heap.Front()) < best,
+			 backwardOpen = !backward.heap.Empty() && backward.heap.GetKey(backward.heap.Front()) < best;
+		
+		if (forwardOpen && (!backwardOpen || forward.heap.GetKey(forward.heap.Front()) <= backward.heap.GetKey(backward.heap.Front()))) {
+			SearchUp(forward, backward, upOffsets, upArcs, best, meet);
+		} else if (backwardOpen) {
+			SearchUp(backward, forward, downOffsets, downArcs, best, meet);
+		} else {
+			break;
+		}
+	}
+	
+	// Expand the arcs up from the source and back down to the target
+	if (path != NULL && meet != -1) {
+		std::vector<NodeID> up;
+		
+		for (NodeID node = meet; node != source; node = forward.parents[node]) {
+			up.push_back(node);
+		}
+		
+		path->push_back(source);
+		for (int i = up.size() - 1; i >= 0; i--) {
+			Unpack(forward.parents[up[i]], up[i], forward.middles[up[i]], *path);
+		}
+		
+		for (NodeID node = meet; node != target; node = backward.parents[node]) {
+			Unpack(node, backward.parents[node], backward.middles[node], *path);
+		}
+	}
+	
+	return best;
+}
+
+// DistanceMatrix
+// params:
+//	sources: This is the nodes the rows of the matrix start at
+//	targets: This is the nodes the columns of the matrix end at
+//	matrix: This is filled row by row with the length of the shortest path
+//	        from every source to every target, infinite if there is none. It
+//	        must have room for sources.size() * targets.size() weights.
+//	threads: This is the amount of threads to use, 0 uses every core
+// Searches upward once from every target, leaving the distance in a
+// bucket at each node reached, then searches upward once from every
+// source and reads the buckets of the nodes it reaches. Every search
+// is shared by a whole row or column instead of being run per pair.
+void ContractionHierarchy::DistanceMatrix(const std::vector<NodeID> & sources, const std::vector<NodeID> & targets, Weight * matrix, int threads) const {
+	const int block = 16;
+	int rows = sources.size(), columns = targets.size();
+	std::vector<std::vector<std::pair<NodeID, BucketEntry> > > found;
+	std::vector<EdgeIndex> bucketOffsets(vertices + 1, 0);
+	std::vector<BucketEntry> buckets;
+	std::atomic<int> next;
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// Every thread needs at least a block of searches to be worth starting
+	if ((rows > columns ? rows : columns) / block < threads) {
+		threads = (rows > columns ? rows : columns) / block;
+		threads = (threads > 0 ? threads : 1);
+	}
+	
+	found.resize(threads);
+	
+	// Search up from every target, the threads take the targets a block at a time
+	next = 0;
+	ParallelThreads([&](int thread, int count) {
+		Side side;
+		int first;
+		
+		PrepareSide(side);
+		
+		while ((first = next.fetch_add(block)) < columns) {
+			for (int column = first; column < first + block && column < columns; column++) {
+				// A target not in the hierarchy leaves its column infinite
+				if (targets[column] < 0 || targets[column] >= vertices) {
+					continue;
+				}
+				
+				// The backward search follows the arcs coming down into each node
+				SearchAll(side, targets[column], downOffsets, downArcs);
+				
+				for (int i = 0; i < side.touched.size(); i++) {
+					BucketEntry entry = { column, side.distances[side.touched[i]] };
+					
+					found[thread].push_back(std::make_pair(side.touched[i], entry));
+				}
+			}
+		}
+	}, threads);
+	
+	// Group the distances found into one bucket per node
+	for (int i = 0; i < threads; i++) {
+		for (EdgeIndex j = 0; j < found[i].size(); j++) {
+			bucketOffsets[found[i][j].first + 1]++;
+		}
+	}
+	
+	for (NodeID i = 0; i < vertices; i++) {
+		bucketOffsets[i + 1] += bucketOffsets[i];
+	}
+	
+	buckets.resize(bucketOffsets[vertices]);
+	for (int i = 0; i < threads; i++) {
+		for (EdgeIndex j = 0; j < found[i].size(); j++) {
+			buckets[bucketOffsets[found[i][j].first]++] = found[i][j].second;
+		}
+		
+		std::vector<std::pair<NodeID, BucketEntry> >().swap(found[i]);
+	}
+	
+	// Filling moved every offset to the start of the next bucket
+	for (NodeID i = vertices; i > 0; i--) {
+		bucketOffsets[i] = bucketOffsets[i - 1];
+	}
+	
+	bucketOffsets[0] = 0;
+	
+	// Search up from every source and read the buckets of every node reached
+	next = 0;
+	ParallelThreads([&](int thread, int count) {
+		Side side;
+		int first;
+		
+		PrepareSide(side);
+		
+		while ((first = next.fetch_add(block)) < rows) {
+			for (int row = first; row < first + block && row < rows; row++) {
+				Weight * distances = matrix + (uint64_t)row * columns;
+				
+				std::fill(distances, distances + columns, InfiniteWeight);
+				
+				// A source not in the hierarchy leaves its row infinite
+				if (sources[row] < 0 || sources[row] >= vertices) {
+					continue;
+				}
+				
+				SearchAll(side, sources[row], upOffsets, upArcs);
+				
+				// The shortest path to every target meets its search at some node
+				for (int i = 0; i < side.touched.size(); i++) {
+					NodeID node = side.touched[i];
+					Weight distance = side.distances[node];
+					
+					for (EdgeIndex j = bucketOffsets[node]; j < bucketOffsets[node + 1]; j++) {
+						if (distance + buckets[j].distance < distances[buckets[j].column]) {
+							distances[buckets[j].column] = distance + buckets[j].distance;
+						}
+					}
+				}
+			}
+		}
+	}, threads);
+	
+	return;
+}
+
+// Save
+// params:
+//	path: This is the path of the file to write
+// Writes the hierarchy to a binary file, returns true if it was written
+bool ContractionHierarchy::Save(const std::string & path) const {
+	std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+	FileHeader header;
+	
+	// Fill in the header
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "CPPGRCH", sizeof(header.magic));
+	header.version = FileVersion;
+	header.byteOrder = 0x01020304;
+	header.nodeIDSize = sizeof(NodeID);
+	header.weightSize = sizeof(Weight);
+	header.vertices = vertices;
+	header.upArcs = upArcs.size();
+	header.downArcs = downArcs.size();
+	
+	// Write the header followed by every array
+	file.write((const char *)&header, sizeof(header));
+	file.write((const char *)upOffsets.data(), sizeof(EdgeIndex) * upOffsets.size());
+	file.write((const char *)upArcs.data(), sizeof(Arc) * upArcs.size());
+	file.write((const char *)downOffsets.data(), sizeof(EdgeIndex) * downOffsets.size());
+	file.write((const char *)downArcs.data(), sizeof(Arc) * downArcs.size());
+	
+	return file.good();
+}
+
+// Load
+// params:
+//	path: This is the path of the file to read
+// Reads a hierarchy written by Save. Returns false and leaves the
+// hierarchy as it was if the file is missing or not a hierarchy file,
+// including when its arcs do not lead to ever more important nodes or
+// a shortcut skips a node that is not below both of its ends.
+bool ContractionHierarchy::Load(const std::string & path) {
+	MappedFile file;
+	const FileHeader * header;
+	bool loaded = false;
+	
+	// If the file could be mapped and is big enough for a header
+	if (file.Open(path) && file.GetSize() >= sizeof(FileHeader)) {
+		header = (const FileHeader *)file.GetData();
+		
+		// If the header matches what this build writes and the file holds every array
+		if (memcmp(header->magic, "CPPGRCH", sizeof(header->magic)) == 0 &&
+			header->version == FileVersion &&
+			header->byteOrder == 0x01020304 &&
+			header->nodeIDSize == sizeof(NodeID) &&
+			header->weightSize == sizeof(Weight) &&
+			header->vertices < (uint64_t)std::numeric_limits<NodeID>::max() &&
+			header->upArcs <= file.GetSize() / sizeof(Arc) && header->downArcs <= file.GetSize() / sizeof(Arc) &&
+			header->vertices + 1 <= (file.GetSize() - sizeof(FileHeader)) / (2 * sizeof(EdgeIndex)) &&
+			sizeof(FileHeader) + sizeof(EdgeIndex) * 2 * (header->vertices + 1) + sizeof(Arc) * (header->upArcs + header->downArcs) == file.GetSize()) {
+			const char * data = file.GetData() + sizeof(FileHeader);
+			std::vector<EdgeIndex> fileUpOffsets(header->vertices + 1), fileDownOffsets(header->vertices + 1);
+			std::vector<Arc> fileUpArcs(header->upArcs), fileDownArcs(header->downArcs);
+			
+			// Copy the arrays out as the arcs leave the later arrays unaligned
+			memcpy(fileUpOffsets.data(), data, sizeof(EdgeIndex) * fileUpOffsets.size());
+			data += sizeof(EdgeIndex) * fileUpOffsets.size();
+			memcpy(fileUpArcs.data(), data, sizeof(Arc) * fileUpArcs.size());
+			data += sizeof(Arc) * fileUpArcs.size();
+			memcpy(fileDownOffsets.data(), data, sizeof(EdgeIndex) * fileDownOffsets.size());
+			data += sizeof(EdgeIndex) * fileDownOffsets.size();
+			memcpy(fileDownArcs.data(), data, sizeof(Arc) * fileDownArcs.size());
+			
+			// Checks that the offsets cover exactly the arcs, never decrease,
+			// and that every arc points at a node and skips a node or none
+			auto valid = [&](const std::vector<EdgeIndex> & offsets, const ArcList & arcs) {
+				bool inBounds = (offsets[0] == 0 && offsets[header->vertices] == arcs.size());
+				
+				for (uint64_t i = 0; inBounds && i < header->vertices; i++) {
+					inBounds = (offsets[i] <= offsets[i + 1]);
+				}
+				
+				for (EdgeIndex i = 0; inBounds && i < arcs.size(); i++) {
+					inBounds = (arcs[i].target >= 0 && (uint64_t)arcs[i].target < header->vertices &&
+								arcs[i].middle >= -1 && arcs[i].middle < (NodeID)header->vertices);
+				}
+				
+				return inBounds;
+			};
+			
+			// Ranks the nodes so every arc leads to a more important node, which
+			// fails if the arcs go round in a cycle, and checks every shortcut
+			// skips a node ranked below both of its ends so unpacking it ends
+			auto ranked = [&]() {
+				std::vector<NodeID> rank(header->vertices, -1), queue;
+				std::vector<EdgeIndex> incoming(header->vertices, 0);
+				bool ordered = true;
+				
+				for (EdgeIndex i = 0; i < fileUpArcs.size(); i++) {
+					incoming[fileUpArcs[i].target]++;
+				}
+				
+				for (EdgeIndex i = 0; i < fileDownArcs.size(); i++) {
+					incoming[fileDownArcs[i].target]++;
+				}
+				
+				for (NodeID i = 0; i < (NodeID)header->vertices; i++) {
+					if (incoming[i] == 0) {
+						queue.push_back(i);
+					}
+				}
+				
+				// Rank a node once every less important node is ranked
+				for (NodeID next = 0; next < queue.size(); next++) {
+					NodeID node = queue[next];
+					
+					rank[node] = next;
+					
+					for (EdgeIndex j = fileUpOffsets[node]; j < fileUpOffsets[node + 1]; j++) {
+						if (--incoming[fileUpArcs[j].target] == 0) {
+							queue.push_back(fileUpArcs[j].target);
+						}
+					}
+					
+					for (EdgeIndex j = fileDownOffsets[node]; j < fileDownOffsets[node + 1]; j++) {
+						if (--incoming[fileDownArcs[j].target] == 0) {
+							queue.push_back(fileDownArcs[j].target);
+						}
+					}
+				}
+				
+				// If a node was never ranked the arcs have a cycle
+				ordered = (queue.size() == header->vertices);
+				
+				for (NodeID i = 0; ordered && i < (NodeID)header->vertices; i++) {
+					for (EdgeIndex j = fileUpOffsets[i]; ordered && j < fileUpOffsets[i + 1]; j++) {
+						NodeID middle = fileUpArcs[j].middle;
+						
+						ordered = (middle == -1 || (rank[middle] < rank[i] && rank[middle] < rank[fileUpArcs[j].target]));
+					}
+					
+					for (EdgeIndex j = fileDownOffsets[i]; ordered && j < fileDownOffsets[i + 1]; j++) {
+						NodeID middle = fileDownArcs[j].middle;
+						
+						ordered = (middle == -1 || (rank[middle] < rank[i] && rank[middle] < rank[fileDownArcs[j].target]));
+					}
+				}
+				
+				return ordered;
+			};
+			
+			// If both sides of the hierarchy stay in bounds and are ordered
+			if (valid(fileUpOffsets, fileUpArcs) && valid(fileDownOffsets, fileDownArcs) && ranked()) {
+				vertices = header->vertices;
+				upOffsets.swap(fileUpOffsets);
+				upArcs.swap(fileUpArcs);
+				downOffsets.swap(fileDownOffsets);
+				downArcs.swap(fileDownArcs);
+				PrepareQueries();
+				
+				loaded = true;
+			}
+		}
+	}
+	
+	return loaded;
+}
+
+// GetNumVertices
+// Returns the number of vertices in the hierarchy
+NodeID ContractionHierarchy::GetNumVertices() const {
+	return vertices;
+}
+
+// GetNumArcs
+// Returns the number of upward and downward arcs, shortcuts included
+EdgeIndex ContractionHierarchy::GetNumArcs() const {
+	return upArcs.size() + downArcs.size();
+}
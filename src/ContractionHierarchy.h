@@ -0,0 +1,224 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector> // For the vector class
+#include <string> // For the string class
+#include <stdint.h> // For the fixed width integer types
+#include "CsrGraph.h" // For the CsrGraph class
+#include "IndexedHeap.h" // For the IndexedHeap class
+
+// ContractionHierarchy
+// This is a Contraction Hierarchies index for fast point to point shortest
+// path queries on a graph that does not change. Build contracts the nodes
+// one at a time, least important first by edge difference, and adds a
+// shortcut around each contracted node wherever a local witness search can
+// not find another path that is as short. A query then only searches upward
+// from both ends, to more important nodes, which touches a tiny part of the
+// graph. The upward edges are packed into compact arrays that can be saved
+// to a file once and loaded back at start up. Queries reuse the workspace
+// inside the hierarchy, so keep one copy per thread.
+class ContractionHierarchy {
+	private:
+		// Arc
+		// An edge of the hierarchy, a shortcut remembers the node it skips
+		struct Arc {
+			NodeID target; // The node at the other end of the arc
+			Weight weight; // The length of the arc
+			NodeID middle; // The node the shortcut skips, -1 for an edge of the graph
+		};
+		
+		typedef std::vector<Arc> ArcList;
+		
+		// Side
+		// The workspace for searching upward from one end of a query
+		struct Side {
+			IndexedHeap<Weight> heap;      // The nodes waiting to be settled
+			std::vector<Weight> distances; // The distance to every node, infinite if unreached
+			std::vector<NodeID> parents;   // The node before every node on its path
+			std::vector<NodeID> middles;   // The middle of the arc from the parent
+			std::vector<NodeID> touched;   // Every node given a distance by the last query
+		};
+		
+		// BucketEntry
+		// The distance from a node up the hierarchy to the target of a column
+		struct BucketEntry {
+			int column;      // The index of the target in the targets of the matrix
+			Weight distance; // The length of the upward path from the node to the target
+		};
+		
+		// FileHeader
+		// This is the header at the start of a saved hierarchy file, the offsets
+		// and arcs of the upward and downward arrays follow it in that order
+		struct FileHeader {
+			char magic[8];         // Always "CPPGRCH\0"
+			uint32_t version;      // The version of the file format
+			uint32_t byteOrder;    // Always 0x01020304 in the writers byte order
+			uint32_t nodeIDSize;   // The size of a NodeID in bytes
+			uint32_t weightSize;   // The size of a weight in bytes
+			uint64_t vertices;     // The number of vertices
+			uint64_t upArcs;       // The number of upward arcs
+			uint64_t downArcs;     // The number of downward arcs
+		};
+		
+		// FileVersion
+		// This is the version of the file format written by Save
+		static const uint32_t FileVersion = 1;
+		
+		// The arcs every node has to more important nodes. Up holds the arcs
+		// leaving a node and down the arcs coming into it, with the target
+		// being the node they come from.
+		NodeID vertices;
+		std::vector<EdgeIndex> upOffsets, downOffsets;
+		std::vector<Arc> upArcs, downArcs;
+		Side forward, backward;
+		
+		// These are only used while building
+		std::vector<ArcList> outArcs, inArcs; // The arcs between nodes not yet contracted
+		std::vector<int> deletedNeighbors;    // How many neighbors of each node are contracted
+		IndexedHeap<Weight> witnessHeap;      // The queue for the witness searches
+		std::vector<Weight> witnessDistances; // The distances found by the witness search
+		std::vector<NodeID> witnessTouched;   // Every node the last witness search reached
+		std::vector<bool> witnessTargets;     // The nodes the witness search has to reach
+		
+		// AddArc
+		// params:
+		//	from: This is the node the arc leaves
+		//	to: This is the node the arc goes to
+		//	weight: This is the length of the arc
+		//	middle: This is the node the arc skips, -1 if it is an edge
+		// Adds the arc to the build graph, or shortens the arc already there
+		void AddArc(NodeID from, NodeID to, Weight weight, NodeID middle);
+		
+		// WitnessSearch
+		// params:
+		//	source: This is the node the search starts from
+		//	skip: This is the node being contracted, which is never entered
+		//	limit: This is the distance past which the search stops
+		//	maxSettled: This is the amount of nodes settled before the search gives up
+		//	targets: This is the amount of nodes marked in witnessTargets
+		// Runs a Dijkstra around the source that avoids the skipped node, filling
+		// witnessDistances. Stops early once every marked node is settled.
+		void WitnessSearch(NodeID source, NodeID skip, Weight limit, int maxSettled, int targets);
+		
+		// Contract
+		// params:
+		//	node: This is the node to contract
+		//	simulate: Is a flag if the shortcuts should only be counted
+		// Finds every shortcut needed to remove the node and returns how many
+		// there are. Unless simulating the shortcuts are added and the node is
+		// taken out of the build graph.
+		int Contract(NodeID node, bool simulate);
+		
+		// GetPriority
+		// params:
+		//	node: This is the node to rate
+		// Returns the edge difference of the node, the shortcuts contracting it
+		// would add less the arcs it would remove, plus its contracted neighbors
+		// so the contraction spreads evenly over the graph
+		float GetPriority(NodeID node);
+		
+		// Reset
+		// params:
+		//	side: This is the workspace to reset
+		// Puts every node the last query touched back to unreached
+		static void Reset(Side & side);
+		
+		// SearchUp
+		// params:
+		//	side: This is the workspace to settle a node from
+		//	other: This is the workspace of the search from the other end
+		//	offsets: This is where the arcs of every node start
+		//	arcs: This is the arcs this side follows
+		//	best: This is the length of the shortest path found so far
+		//	meet: This is the node the shortest path found so far goes through
+		// Settles the closest node of the side and relaxes its upward arcs
+		static void SearchUp(Side & side, Side & other, const std::vector<EdgeIndex> & offsets, const std::vector<Arc> & arcs, Weight & best, NodeID & meet);
+		
+		// Unpack
+		// params:
+		//	from: This is the node the arc leaves
+		//	to: This is the node the arc goes to
+		//	middle: This is the node the arc skips, -1 if it is an edge
+		//	path: This has every node the arc passes through after from added
+		// Expands a shortcut back into the edges of the graph it stands for
+		void Unpack(NodeID from, NodeID to, NodeID middle, std::vector<NodeID> & path) const;
+		
+		// SearchAll
+		// params:
+		//	side: This is the workspace to search with
+		//	start: This is the node the search starts from
+		//	offsets: This is where the arcs of every node start
+		//	arcs: This is the arcs the search follows
+		// Runs a full upward search from the node, every node it reaches is
+		// left in the touched list of the side with its final distance
+		static void SearchAll(Side & side, NodeID start, const std::vector<EdgeIndex> & offsets, const std::vector<Arc> & arcs);
+		
+		// PrepareSide
+		// params:
+		//	side: This is the workspace to size
+		// Sizes a query workspace for the hierarchy
+		void PrepareSide(Side & side) const;
+		
+		// PrepareQueries
+		// Sizes the query workspaces for the hierarchy
+		void PrepareQueries();
+	
+	public:
+		// Default Constructor
+		// Creates an empty hierarchy
+		ContractionHierarchy();
+		
+		// Build
+		// params:
+		//	graph: This is the graph to build the hierarchy for
+		// Contracts every node of the graph and packs the upward arcs
+		void Build(const CsrGraph & graph);
+		
+		// Query
+		// params:
+		//	source: This is the node the path starts at
+		//	target: This is the node the path ends at
+		//	path: This is filled with the nodes on the path if it is not NULL
+		// Searches upward from both ends and returns the length of the shortest
+		// path, infinite if there is none
+		Weight Query(NodeID source, NodeID target, std::vector<NodeID> * path = NULL);
+		
+		// DistanceMatrix
+		// params:
+		//	sources: This is the nodes the rows of the matrix start at
+		//	targets: This is the nodes the columns of the matrix end at
+		//	matrix: This is filled row by row with the length of the shortest path
+		//	        from every source to every target, infinite if there is none. It
+		//	        must have room for sources.size() * targets.size() weights.
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Searches upward once from every target, leaving the distance in a
+		// bucket at each node reached, then searches upward once from every
+		// source and reads the buckets of the nodes it reaches. Every search
+		// is shared by a whole row or column instead of being run per pair.
+		void DistanceMatrix(const std::vector<NodeID> & sources, const std::vector<NodeID> & targets, Weight * matrix, int threads = 0) const;
+		
+		// Save
+		// params:
+		//	path: This is the path of the file to write
+		// Writes the hierarchy to a binary file, returns true if it was written
+		bool Save(const std::string & path) const;
+		
+		// Load
+		// params:
+		//	path: This is the path of the file to read
+		// Reads a hierarchy written by Save. Returns false and leaves the
+		// hierarchy as it was if the file is missing or not a hierarchy file,
+		// including when its arcs do not lead to ever more important nodes or
+		// a shortcut skips a node that is not below both of its ends.
+		bool Load(const std::string & path);
+		
+		// GetNumVertices
+		// Returns the number of vertices in the hierarchy
+		NodeID GetNumVertices() const;
+		
+		// GetNumArcs
+		// Returns the number of upward and downward arcs, shortcuts included
+		EdgeIndex GetNumArcs() const;
+}; // End ContractionHierarchy Class
+
+#endif
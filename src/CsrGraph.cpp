@@ -0,0 +1,1590 @@
+#include <iostream>
+#include <fstream> // For writing graph files
+#include <cstring> // For memcmp and memcpy
+#include <limits> // For the numeric_limits class
+#include <cmath>
+#include <algorithm> // For the lower_bound and sort functions
+#include <atomic> // For the atomic class
+#include <random> // For the mt19937 class
+#include "Parallel.h"
+#include "RadixSort.h"
+#include "UnionFind.h"
+#include "IndexedHeap.h"
+#include "RadixHeap.h"
+#include "CsrGraph.h"
+
+// Default constructor
+// Creates an empty graph with no vertices
+CsrGraph::CsrGraph() {
+	offsetStorage.assign(1, 0);
+	BindStorage();
+	return;
+}
+
+// Copy Constructor
+// params:
+//	graph: This is the graph we wish to copy
+// Copies the graph, a mapped graph shares the mapping
+CsrGraph::CsrGraph(const CsrGraph & graph) {
+	*this = graph;
+	return;
+}
+
+// operator= Overload
+// params:
+//	graph: This is the graph we wish to copy
+// Copies the graph, a mapped graph shares the mapping
+CsrGraph & CsrGraph::operator=(const CsrGraph & graph) {
+	if (this == &graph) {
+		return *this;
+	}
+	
+	offsetStorage = graph.offsetStorage;
+	targetStorage = graph.targetStorage;
+	weightStorage = graph.weightStorage;
+	mapping = graph.mapping;
+	
+	// If the graph is mapped share its arrays
+	if (mapping) {
+		offsets = graph.offsets;
+		targets = graph.targets;
+		weights = graph.weights;
+		vertices = graph.vertices;
+		edges = graph.edges;
+	} else {
+		// Otherwise point at our own copies
+		BindStorage();
+	}
+	
+	return *this;
+}
+
+// BindStorage
+// Points the arrays at the storage vectors once they have been filled
+void CsrGraph::BindStorage() {
+	offsets = offsetStorage.data();
+	targets = targetStorage.data();
+	weights = weightStorage.data();
+	vertices = offsetStorage.size() - 1;
+	edges = targetStorage.size();
+	mapping.reset();
+	
+	return;
+}
+
+// Save
+// params:
+//	path: This is the path of the file to write
+// Writes the graph to a binary file that Load can map back in,
+// returns true if the file was written
+bool CsrGraph::Save(const std::string & path) const {
+	std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+	FileHeader header;
+	const char padding[8] = {0};
+	
+	// Fill in the header, every array starts on an eight byte boundary
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "CPPGRAPH", sizeof(header.magic));
+	header.version = FileVersion;
+	header.byteOrder = 0x01020304;
+	header.nodeIDSize = sizeof(NodeID);
+	header.weightSize = (WeightedEdges ? sizeof(Weight) : 0);
+	header.vertices = vertices;
+	header.edges = edges;
+	header.offsetsPos = (sizeof(FileHeader) + 7) / 8 * 8;
+	header.targetsPos = (header.offsetsPos + sizeof(EdgeIndex) * (vertices + 1) + 7) / 8 * 8;
+	header.weightsPos = (header.targetsPos + sizeof(NodeID) * edges + 7) / 8 * 8;
+	
+	// Write the header followed by every array
+	file.write((const char *)&header, sizeof(header));
+	file.write(padding, header.offsetsPos - sizeof(header));
+	file.write((const char *)offsets, sizeof(EdgeIndex) * (vertices + 1));
+	file.write(padding, header.targetsPos - header.offsetsPos - sizeof(EdgeIndex) * (vertices + 1));
+	file.write((const char *)targets, sizeof(NodeID) * edges);
+	file.write(padding, header.weightsPos - header.targetsPos - sizeof(NodeID) * edges);
+	file.write((const char *)weights, header.weightSize * edges);
+	
+	return file.good();
+}
+
+// Load
+// params:
+//	path: This is the path of the file to read
+//	verify: Is a flag if every offset and target is checked
+// Maps a file written by Save and uses it as this graph without
+// reading or copying it. Only the header and sizes are checked unless
+// verifying, which reads the offsets and targets through once. Returns
+// false and leaves the graph as it was if the file is not valid.
+bool CsrGraph::Load(const std::string & path, bool verify) {
+	std::shared_ptr<MappedFile> file(new MappedFile());
+	const FileHeader * header;
+	bool loaded = false;
+	
+	// If the file could be mapped and is big enough for a header
+	if (file->Open(path) && file->GetSize() >= sizeof(FileHeader)) {
+		header = (const FileHeader *)file->GetData();
+		
+		// If the header matches what this build writes
+		if (memcmp(header->magic, "CPPGRAPH", sizeof(header->magic)) == 0 &&
+			header->version == FileVersion &&
+			header->byteOrder == 0x01020304 &&
+			header->nodeIDSize == sizeof(NodeID) &&
+			header->weightSize == (WeightedEdges ? sizeof(Weight) : 0) &&
+			header->vertices < (uint64_t)std::numeric_limits<NodeID>::max() &&
+			header->offsetsPos % 8 == 0 && header->targetsPos % 8 == 0 && header->weightsPos % 8 == 0 &&
+			header->offsetsPos <= file->GetSize() && header->targetsPos <= file->GetSize() && header->weightsPos <= file->GetSize() &&
+			header->vertices + 1 <= (file->GetSize() - header->offsetsPos) / sizeof(EdgeIndex) &&
+			header->edges <= (file->GetSize() - header->targetsPos) / sizeof(NodeID) &&
+			(header->weightSize == 0 || header->edges <= (file->GetSize() - header->weightsPos) / header->weightSize)) {
+			const EdgeIndex * fileOffsets = (const EdgeIndex *)(file->GetData() + header->offsetsPos);
+			const NodeID * fileTargets = (const NodeID *)(file->GetData() + header->targetsPos);
+			bool valid = (fileOffsets[0] == 0 && fileOffsets[header->vertices] == header->edges);
+			
+			// When verifying, check in one pass that the offsets never decrease
+			// and every target is a node, so no algorithm can read out of bounds
+			for (uint64_t i = 0; verify && valid && i < header->vertices; i++) {
+				valid = (fileOffsets[i] <= fileOffsets[i + 1]);
+			}
+			
+			for (uint64_t i = 0; verify && valid && i < header->edges; i++) {
+				valid = (fileTargets[i] >= 0 && (uint64_t)fileTargets[i] < header->vertices);
+			}
+			
+			// If the offsets and targets describe a graph
+			if (valid) {
+				// Point straight into the mapping
+				offsets = fileOffsets;
+				targets = fileTargets;
+				weights = (WeightedEdges ? (const Weight *)(file->GetData() + header->weightsPos) : NULL);
+				vertices = header->vertices;
+				edges = header->edges;
+				
+				// Release any in memory arrays and hold on to the mapping
+				std::vector<EdgeIndex>().swap(offsetStorage);
+				std::vector<NodeID>().swap(targetStorage);
+				std::vector<Weight>().swap(weightStorage);
+				mapping = file;
+				
+				loaded = true;
+			}
+		}
+	}
+	
+	return loaded;
+}
+
+// IsMapped
+// Returns true if the graph is backed by a mapped file
+bool CsrGraph::IsMapped() const {
+	return (mapping.get() != NULL);
+}
+
+// GetNumVertices
+// Returns the number of vertices in the graph
+NodeID CsrGraph::GetNumVertices() const {
+	return vertices;
+}
+
+// GetNumEdges
+// Returns the number of edges in the graph
+EdgeIndex CsrGraph::GetNumEdges() const {
+	return edges;
+}
+
+// GetBegin
+// params:
+//	node: This is the node whose neighbors we want
+// Returns the index of the first edge leaving the node
+EdgeIndex CsrGraph::GetBegin(NodeID node) const {
+	return offsets[node];
+}
+
+// GetEnd
+// params:
+//	node: This is the node whose neighbors we want
+// Returns one past the index of the last edge leaving the node
+EdgeIndex CsrGraph::GetEnd(NodeID node) const {
+	return offsets[node + 1];
+}
+
+// GetDegree
+// params:
+//	node: This is the node whose degree we want
+// Returns the number of edges leaving the node
+EdgeIndex CsrGraph::GetDegree(NodeID node) const {
+	return (offsets[node + 1] - offsets[node]);
+}
+
+// GetTarget
+// params:
+//	edge: This is the index of the edge
+// Returns the end node ID of the edge
+NodeID CsrGraph::GetTarget(EdgeIndex edge) const {
+	return targets[edge];
+}
+
+// GetWeight
+// params:
+//	edge: This is the index of the edge
+// Returns the weight associated with the edge, always 1 when the
+// library is built with CPPGRAPH_UNWEIGHTED
+Weight CsrGraph::GetWeight(EdgeIndex edge) const {
+	return (WeightedEdges ? weights[edge] : 1);
+}
+
+// Contains
+// params:
+//	node: This is the node we are looking for
+// Returns true if the graph contains the node, false otherwise
+bool CsrGraph::Contains(NodeID node) const {
+	return (node >= 0 && node < GetNumVertices());
+}
+
+// FindEdge
+// params:
+//	startID: This is the node id of the starting node
+//	endID: This is the node id of the ending node
+// Returns the index of the edge from the start to the end node,
+// GetNumEdges() if there is no such edge
+EdgeIndex CsrGraph::FindEdge(NodeID startID, NodeID endID) const {
+	EdgeIndex edge = edges;
+	
+	// If the starting node exists
+	if (Contains(startID)) {
+		// Binary search its sorted neighbors
+		const NodeID * first = targets + offsets[startID], * last = targets + offsets[startID + 1],
+					 * found = std::lower_bound(first, last, endID);
+		
+		if (found != last && *found == endID) {
+			edge = found - targets;
+		}
+	}
+	
+	return edge;
+}
+
+// Transpose
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Returns a snapshot with every edge reversed, so the neighbors of a node
+// are the nodes with an edge into it. The neighbors stay sorted by ID.
+CsrGraph CsrGraph::Transpose(int threads) const {
+	CsrGraph transposed;
+	std::vector<std::atomic<EdgeIndex> > next(vertices);
+	
+	transposed.offsetStorage.assign(vertices + 1, 0);
+	transposed.targetStorage.resize(edges);
+	transposed.weightStorage.resize(WeightedEdges ? edges : 0);
+	
+	// Count the edges into every node
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			next[i].store(0, std::memory_order_relaxed);
+		}
+	}, threads);
+	
+	ParallelFor(0, edges, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			next[targets[i]].fetch_add(1, std::memory_order_relaxed);
+		}
+	}, threads);
+	
+	// Work out where each nodes incoming edges go
+	for (NodeID i = 0; i < vertices; i++) {
+		transposed.offsetStorage[i + 1] = transposed.offsetStorage[i] + next[i].load(std::memory_order_relaxed);
+		next[i].store(transposed.offsetStorage[i], std::memory_order_relaxed);
+	}
+	
+	// Scatter every edge reversed
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			for (EdgeIndex j = offsets[i]; j < offsets[i + 1]; j++) {
+				EdgeIndex at = next[targets[j]].fetch_add(1, std::memory_order_relaxed);
+				
+				transposed.targetStorage[at] = i;
+				
+				if (WeightedEdges) {
+					transposed.weightStorage[at] = weights[j];
+				}
+			}
+		}
+	}, threads);
+	
+	// The threads raced each other so sort every nodes neighbors by ID again
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		std::vector<std::pair<NodeID, Weight> > sorted;
+		
+		for (uint64_t i = first; i < last; i++) {
+			EdgeIndex begin = transposed.offsetStorage[i], end = transposed.offsetStorage[i + 1];
+			
+			sorted.clear();
+			for (EdgeIndex j = begin; j < end; j++) {
+				sorted.push_back(std::make_pair(transposed.targetStorage[j], (WeightedEdges ? transposed.weightStorage[j] : 1)));
+			}
+			
+			std::sort(sorted.begin(), sorted.end());
+			
+			for (EdgeIndex j = begin; j < end; j++) {
+				transposed.targetStorage[j] = sorted[j - begin].first;
+				
+				if (WeightedEdges) {
+					transposed.weightStorage[j] = sorted[j - begin].second;
+				}
+			}
+		}
+	}, threads);
+	
+	transposed.BindStorage();
+	
+	return transposed;
+}
+
+// GatherEdges
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Gathers one copy of every edge ordered by start then end node. An
+// edge whose reverse is at least as light is left out, so undirected
+// edges appear once while the lightest direction of a pair of
+// directed edges is always kept.
+EdgeList CsrGraph::GatherEdges(int threads) const {
+	std::vector<EdgeIndex> kept(vertices + 1, 0);
+	EdgeList e;
+	
+	// Count the edges each node keeps
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			for (EdgeIndex j = offsets[i]; j < offsets[i + 1]; j++) {
+				if (IsCanonical(i, j)) {
+					kept[i + 1]++;
+				}
+			}
+		}
+	}, threads);
+	
+	// Work out where each nodes edges go
+	for (NodeID i = 0; i < vertices; i++) {
+		kept[i + 1] += kept[i];
+	}
+	
+	// Append every kept edge once, in place
+	e.resize(kept[vertices], Edge(0, 0));
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			EdgeIndex next = kept[i];
+			
+			for (EdgeIndex j = offsets[i]; j < offsets[i + 1]; j++) {
+				if (IsCanonical(i, j)) {
+					e[next++] = Edge(i, targets[j], GetWeight(j));
+				}
+			}
+		}
+	}, threads);
+	
+	return e;
+}
+
+// GetSortedEdges
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Gathers one copy of every edge and sorts them by weight. Edges of the
+// same weight stay ordered by start then end node, which is KruskalOrder.
+EdgeList CsrGraph::GetSortedEdges(int threads) const {
+	EdgeList e = GatherEdges(threads);
+	
+	// Sort the edges by weight, ties stay in the order they were gathered
+	RadixSort(e, [](const Edge & edge) {
+		return WeightToKey(edge.GetWeight());
+	}, threads);
+	
+	return e;
+}
+
+// KruskalOrder
+// params:
+//	one: This is the first edge
+//	two: This is the second edge
+// Returns true if the first edge comes before the second in the order
+// Kruskals Algorithm takes them in, by weight then start then end node.
+// Every MST algorithm breaks ties this way so they all build the same forest.
+bool CsrGraph::KruskalOrder(const Edge & one, const Edge & two) {
+	WeightKey oneKey = WeightToKey(one.GetWeight()), twoKey = WeightToKey(two.GetWeight());
+	
+	if (oneKey != twoKey) {
+		return oneKey < twoKey;
+	}
+	
+	if (one.GetStartID() != two.GetStartID()) {
+		return one.GetStartID() < two.GetStartID();
+	}
+	
+	return one.GetID() < two.GetID();
+}
+
+// FilterKruskal
+// params:
+//	e: This is the list of edges being worked on
+//	buffer: This is scratch space as big as the edge list
+//	first: This is the first edge of the range to add
+//	last: This is one past the last edge of the range to add
+//	sets: This tracks which nodes the forest already connects
+//	forest: This is the forest being built
+//	threads: This is the amount of threads to use, 0 uses every core
+// Adds the edges of the range to the forest in KruskalOrder. Big ranges are
+// split around a pivot, the light side is added first and then every heavy
+// edge that would close a cycle is filtered out before the heavy side is
+// looked at, so most heavy edges are never sorted.
+void CsrGraph::FilterKruskal(EdgeList & e, EdgeList & buffer, EdgeIndex first, EdgeIndex last, ConcurrentUnionFind & sets, SpanningForest & forest, int threads) const {
+	const EdgeIndex baseSize = 4096;
+	
+	// While the range is too big to just sort
+	while (last - first > baseSize && (NodeID)forest.edges.size() < vertices - 1) {
+		// Take the median of three edges as the pivot
+		Edge a = e[first], b = e[first + (last - first) / 2], c = e[last - 1];
+		
+		if (KruskalOrder(b, a)) {
+			std::swap(a, b);
+		}
+		
+		if (KruskalOrder(c, b)) {
+			b = (KruskalOrder(c, a) ? a : c);
+		}
+		
+		// Split the range into the edges up to the pivot and the heavier ones
+		EdgeIndex middle = ParallelPartition(e, buffer, first, last, [&](const Edge & edge) {
+			return !KruskalOrder(b, edge);
+		}, threads);
+		
+		// If the pivot did not split the range fall back to sorting all of it
+		if (middle == first || middle == last) {
+			break;
+		}
+		
+		// Add the light edges first
+		FilterKruskal(e, buffer, first, middle, sets, forest, threads);
+		
+		// Drop every heavy edge whose nodes are already connected
+		last = ParallelFilter(e, buffer, middle, last, [&](const Edge & edge) {
+			return sets.Find(edge.GetStartID()) != sets.Find(edge.GetID());
+		}, threads);
+		first = middle;
+	}
+	
+	// Sort what is left of the range and add it like Kruskals Algorithm
+	std::sort(e.begin() + first, e.begin() + last, KruskalOrder);
+	
+	for (EdgeIndex i = first; i < last && (NodeID)forest.edges.size() < vertices - 1; i++) {
+		// If the nodes are not connected yet add the edge to the forest
+		if (sets.Union(e[i].GetStartID(), e[i].GetID())) {
+			forest.Add(e[i]);
+		}
+	}
+	
+	return;
+}
+
+// IsCanonical
+// params:
+//	node: This is the node the edge leaves
+//	edge: This is the index of the edge
+// Returns true if the edge is the copy GatherEdges keeps, which is
+// every edge to a higher ID and any edge whose reverse is heavier or missing
+bool CsrGraph::IsCanonical(NodeID node, EdgeIndex edge) const {
+	bool canonical = (node < targets[edge]);
+	
+	if (!canonical) {
+		EdgeIndex reverse = FindEdge(targets[edge], node);
+		
+		canonical = (reverse == edges || GetWeight(reverse) > GetWeight(edge));
+	}
+	
+	return canonical;
+}
+
+// PrimsAlgorithm
+// params:
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the graph and returns the produced MSF
+AdjList CsrGraph::PrimsAlgorithm(NodeID start) const {
+	SpanningForest forest;
+	
+	PrimsAlgorithm(forest, start);
+	
+	return forest.ToAdjList();
+}
+
+// PrimsAlgorithm
+// params:
+//	forest: This is filled with the edges of the produced MSF
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the graph, every forest edge goes from the
+// node already in the tree to the node it brought in
+void CsrGraph::PrimsAlgorithm(SpanningForest & forest, NodeID start) const {
+	std::vector<NodeID> parents;
+	
+	forest.Reset(vertices);
+	RunPrims(start, parents, &forest);
+	
+	return;
+}
+
+// PrimsAlgorithm
+// params:
+//	parents: This is filled with the parent of every node in the MSF
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the graph and returns the weight of the MSF.
+// The root of every tree is its own parent.
+Weight CsrGraph::PrimsAlgorithm(std::vector<NodeID> & parents, NodeID start) const {
+	return RunPrims(start, parents, NULL);
+}
+
+// RunPrims
+// params:
+//	start: This is the starting node for the produced MSF
+//	parents: This is filled with the parent of every node in the MSF
+//	forest: This is added every forest edge as it is taken if it is not NULL
+// Grows a tree from the start node, then from every node it could not
+// reach so that the result spans the whole forest. Returns its weight.
+Weight CsrGraph::RunPrims(NodeID start, std::vector<NodeID> & parents, SpanningForest * forest) const {
+	IndexedHeap <Weight> nodes(vertices);
+	std::vector<Weight> costs(vertices, InfiniteWeight);
+	std::vector<bool> visited(vertices, false);
+	Weight weight = 0;
+	
+	parents.assign(vertices, -1);
+	
+	// An empty graph has an empty forest
+	if (vertices == 0) {
+		return weight;
+	}
+	
+	// Clamp start inside the bounds of the graphs
+	if (!Contains(start))
+		start = 0;
+	
+	for (NodeID i = -1; i < vertices; i++) {
+		NodeID root = (i == -1 ? start : i);
+		
+		// If this node is already in a tree move on
+		if (visited[root]) {
+			continue;
+		}
+		
+		// The root costs nothing and is its own parent
+		costs[root] = 0;
+		parents[root] = root;
+		nodes.Push(root, 0);
+		
+		// While there are nodes on the edge of the tree
+		while (!nodes.Empty()) {
+			// Get the node with the cheapest connection to the tree
+			NodeID min = nodes.Pop();
+			visited[min] = true;
+			
+			// If this node is not the root node its edge joins the forest
+			if (min != root) {
+				weight += costs[min];
+				
+				if (forest != NULL) {
+					forest->Add(Edge(parents[min], min, costs[min]));
+				}
+			}
+			
+			// For every neighbor to this node
+			for (EdgeIndex j = offsets[min]; j < offsets[min + 1]; j++) {
+				NodeID neighbor = targets[j];
+				
+				// If this node has not been visited already and if
+				// this edge is a cheaper way to connect it
+				if (!visited[neighbor] && GetWeight(j) < costs[neighbor]) {
+					// Update the cost values
+					costs[neighbor] = GetWeight(j);
+					parents[neighbor] = min;
+					
+					// Add the node to the heap or lower its key
+					nodes.PushOrDecrease(neighbor, GetWeight(j));
+				}
+			}
+		}
+	}
+	
+	return weight;
+}
+
+// KruskalsAlgorithm
+// Performs Kruskals Algorithm on the graph and returns an
+// adjacency list that makes a MSF
+AdjList CsrGraph::KruskalsAlgorithm() const {
+	SpanningForest forest;
+	
+	KruskalsAlgorithm(forest);
+	
+	return forest.ToAdjList();
+}
+
+// KruskalsAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+// Performs Kruskals Algorithm on the graph
+void CsrGraph::KruskalsAlgorithm(SpanningForest & forest) const {
+	EdgeList e = GetSortedEdges();
+	
+	forest.Reset(vertices);
+	
+	// Create a UnionFind DS with the size of the amount of nodes
+	UnionFind ufn(GetNumVertices());
+	
+	// For every edge in the sorted edges list
+	for (EdgeIndex i = 0; i < e.size(); i++) {
+		// Find the set that each point belongs to
+		NodeID x = ufn.Find(e[i].GetStartID()),
+			   y = ufn.Find(e[i].GetID());
+		
+		// If the points are not in the same set
+		if (x != y) {
+			// Merge the sets
+			ufn.Union(x, y);
+			
+			// Add the edge to the forest
+			forest.Add(e[i]);
+		}
+	}
+	
+	return;
+}
+
+// FilterKruskalAlgorithm
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs the Filter-Kruskal Algorithm on the graph and returns the same
+// MSF as KruskalsAlgorithm. The partitioning and filtering run in parallel.
+AdjList CsrGraph::FilterKruskalAlgorithm(int threads) const {
+	SpanningForest forest;
+	
+	FilterKruskalAlgorithm(forest, threads);
+	
+	return forest.ToAdjList();
+}
+
+// FilterKruskalAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs the Filter-Kruskal Algorithm on the graph and finds the same
+// MSF as KruskalsAlgorithm
+void CsrGraph::FilterKruskalAlgorithm(SpanningForest & forest, int threads) const {
+	EdgeList e = GatherEdges(threads), buffer(e);
+	ConcurrentUnionFind sets(GetNumVertices());
+	
+	forest.Reset(vertices);
+	FilterKruskal(e, buffer, 0, e.size(), sets, forest, threads);
+	
+	return;
+}
+
+// BoruvkaAlgorithm
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs Boruvkas Algorithm on the graph and returns the same MSF as
+// KruskalsAlgorithm
+AdjList CsrGraph::BoruvkaAlgorithm(int threads) const {
+	SpanningForest forest;
+	
+	BoruvkaAlgorithm(forest, threads);
+	
+	return forest.ToAdjList();
+}
+
+// BoruvkaAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs Boruvkas Algorithm on the graph and finds the same MSF as
+// KruskalsAlgorithm. Every round each component picks its lightest
+// outgoing edge in parallel, the picked edges merge the components and
+// every edge left inside a component is filtered out.
+void CsrGraph::BoruvkaAlgorithm(SpanningForest & forest, int threads) const {
+	const EdgeIndex none = ~(EdgeIndex)0;
+	EdgeList e = GetSortedEdges(threads), buffer(e), picks;
+	EdgeIndex remaining = e.size();
+	ConcurrentUnionFind sets(GetNumVertices());
+	std::vector<std::atomic<EdgeIndex> > lightest(GetNumVertices());
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	std::vector<EdgeList> picked(threads);
+	
+	// The edges are in KruskalOrder, so the lightest edge of a component is
+	// simply the one with the smallest index, which makes every tie the same
+	// as Kruskals Algorithm and keeps the picked edges from forming a cycle
+	while (remaining > 0 && (NodeID)picks.size() < GetNumVertices() - 1) {
+		// Forget the last rounds picks
+		ParallelFor(0, GetNumVertices(), [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				lightest[i].store(none, std::memory_order_relaxed);
+			}
+		}, threads);
+		
+		// Offer every edge to the components on both of its ends
+		ParallelFor(0, remaining, [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				NodeID roots[2] = { sets.Find(e[i].GetStartID()), sets.Find(e[i].GetID()) };
+				
+				for (int j = 0; j < 2; j++) {
+					EdgeIndex current = lightest[roots[j]].load(std::memory_order_relaxed);
+					
+					// Keep the smallest index, retrying if another thread changed it
+					while (i < current && !lightest[roots[j]].compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+					}
+				}
+			}
+		}, threads);
+		
+		// Merge every component along its lightest edge, an edge picked by
+		// both of its components only merges them once
+		ParallelFor(0, GetNumVertices(), [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				EdgeIndex edge = lightest[i].load(std::memory_order_relaxed);
+				
+				if (edge != none && sets.Union(e[edge].GetStartID(), e[edge].GetID())) {
+					picked[thread].push_back(e[edge]);
+				}
+			}
+		}, threads);
+		
+		for (int i = 0; i < threads; i++) {
+			picks.insert(picks.end(), picked[i].begin(), picked[i].end());
+			picked[i].clear();
+		}
+		
+		// Contract the components by dropping every edge inside one
+		remaining = ParallelFilter(e, buffer, 0, remaining, [&](const Edge & edge) {
+			return sets.Find(edge.GetStartID()) != sets.Find(edge.GetID());
+		}, threads);
+	}
+	
+	// Add the forest in the order Kruskals Algorithm would have
+	std::sort(picks.begin(), picks.end(), KruskalOrder);
+	
+	forest.Reset(vertices);
+	forest.edges.swap(picks);
+	for (EdgeIndex i = 0; i < forest.edges.size(); i++) {
+		forest.weight += forest.edges[i].GetWeight();
+	}
+	
+	return;
+}
+
+// RunDijkstra
+// params:
+//	source: This is the node the search starts from
+//	target: This is the node the search stops at, -1 to search everything
+//	queue: This is the priority queue to run on
+//	tree: This is filled with the distances and parents
+// Runs Dijkstras Algorithm from the source until the target is settled
+// or every reachable node is
+template <class Queue>
+void CsrGraph::RunDijkstra(NodeID source, NodeID target, Queue & queue, ShortestPathTree & tree) const {
+	NodeID node;
+	
+	// Every node starts out unreached
+	tree.source = source;
+	tree.distances.assign(vertices, InfiniteWeight);
+	tree.parents.assign(vertices, -1);
+	
+	// If the source is not in the graph there is nothing to search
+	if (!Contains(source)) {
+		return;
+	}
+	
+	queue.Resize(vertices);
+	tree.distances[source] = 0;
+	queue.Push(source, 0);
+	
+	// While there are nodes left to settle, closest first
+	while ((node = queue.Pop()) != -1) {
+		Weight distance = tree.distances[node];
+		
+		// If this is the target its distance is final
+		if (node == target) {
+			break;
+		}
+		
+		// For every neighbor to this node
+		for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+			NodeID neighbor = targets[j];
+			
+			// If going through this node is a shorter way to the neighbor
+			if (distance + GetWeight(j) < tree.distances[neighbor]) {
+				tree.distances[neighbor] = distance + GetWeight(j);
+				tree.parents[neighbor] = node;
+				
+				// Add the neighbor to the queue or lower its key
+				queue.PushOrDecrease(neighbor, tree.distances[neighbor]);
+			}
+		}
+	}
+	
+	return;
+}
+
+// Dijkstra
+// params:
+//	source: This is the node the search starts from
+//	queue: This is the priority queue to run on
+// Runs Dijkstras Algorithm from the source and returns the distance to
+// and parent of every node. The weights must not be negative.
+ShortestPathTree CsrGraph::Dijkstra(NodeID source, ShortestPathQueue queue) const {
+	return Dijkstra(source, -1, queue);
+}
+
+// Dijkstra
+// params:
+//	source: This is the node the search starts from
+//	target: This is the node the search stops at
+//	queue: This is the priority queue to run on
+// Runs Dijkstras Algorithm from the source and stops as soon as the target
+// is settled. The distance and path to the target are final, the other
+// nodes only hold what the search had found so far.
+ShortestPathTree CsrGraph::Dijkstra(NodeID source, NodeID target, ShortestPathQueue queue) const {
+	ShortestPathTree tree;
+	
+	if (queue == RadixHeapQueue) {
+		RadixHeap nodes;
+		RunDijkstra(source, target, nodes, tree);
+	} else {
+		IndexedHeap <Weight> nodes;
+		RunDijkstra(source, target, nodes, tree);
+	}
+	
+	return tree;
+}
+
+// GetAutoDelta
+// Picks a bucket width for DeltaStepping from the edge weights. Following
+// Meyer and Sanders the width is about the largest weight over the average
+// degree, so each node has about one light edge to relax per bucket. The
+// largest weight is the 99th percentile of a sample of the weights so one
+// outlier can not blow the buckets up, and the width never drops below the
+// lightest positive weight so there is always something light to relax.
+Weight CsrGraph::GetAutoDelta() const {
+	const EdgeIndex samples = 4096;
+	std::vector<Weight> sample;
+	Weight delta = 0, lightest = InfiniteWeight;
+	
+	// Take evenly spaced positive weights
+	for (EdgeIndex i = 0; i < edges; i += (edges > samples ? edges / samples : 1)) {
+		if (GetWeight(i) > 0) {
+			sample.push_back(GetWeight(i));
+			
+			if (GetWeight(i) < lightest) {
+				lightest = GetWeight(i);
+			}
+		}
+	}
+	
+	// If there are weights to go on
+	if (sample.size() > 0) {
+		std::vector<Weight>::iterator high = sample.begin() + (sample.size() - 1) * 99 / 100;
+		double degree = (double)edges / vertices;
+		
+		std::nth_element(sample.begin(), high, sample.end());
+		delta = (Weight)(*high / (degree > 1 ? degree : 1));
+		
+		if (delta < lightest) {
+			delta = lightest;
+		}
+	}
+	
+	// Every weight is zero, any width will do
+	if (!(delta > 0)) {
+		delta = 1;
+	}
+	
+	return delta;
+}
+
+// DistanceState
+// This is the distance and parent of every node during DeltaStepping, which
+// have to change together. When a weight key and a NodeID fit in 64 bits
+// they are packed into one word, the key above the parent, and change in one
+// compare and swap. Otherwise every node has an atomic key and its parent is
+// written under one of a few spin locks.
+template <bool Packed>
+class DistanceState;
+
+template <>
+class DistanceState<true> {
+	private:
+		std::vector<std::atomic<uint64_t> > state; // The packed key and parent of every node
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	size: This is the amount of nodes
+		DistanceState(NodeID size) : state(size) {
+			return;
+		}
+		
+		// Reset
+		// params:
+		//	node: This is the node to reset
+		// Marks the node unreached
+		void Reset(NodeID node) {
+			state[node].store(~(uint64_t)0, std::memory_order_relaxed);
+			return;
+		}
+		
+		// GetKey
+		// params:
+		//	node: This is the node whose distance we want
+		// Returns the distance key of the node, all ones if it is unreached
+		WeightKey GetKey(NodeID node) const {
+			return (WeightKey)(state[node].load(std::memory_order_relaxed) >> 32);
+		}
+		
+		// GetParent
+		// params:
+		//	node: This is the node whose parent we want
+		// Returns the parent of the node, -1 if it has none
+		NodeID GetParent(NodeID node) const {
+			return (NodeID)(int32_t)(uint32_t)state[node].load(std::memory_order_relaxed);
+		}
+		
+		// Lower
+		// params:
+		//	node: This is the node to lower
+		//	key: This is the key of the new distance
+		//	parent: This is the node the new distance comes through
+		// Lowers the distance of the node if the key is strictly smaller,
+		// returns true if it was lowered
+		bool Lower(NodeID node, WeightKey key, NodeID parent) {
+			uint64_t packed = (uint64_t)key << 32 | (uint32_t)parent,
+					 current = state[node].load(std::memory_order_relaxed);
+			
+			// While this is strictly shorter than what the node has
+			while ((packed >> 32) < (current >> 32)) {
+				if (state[node].compare_exchange_weak(current, packed)) {
+					return true;
+				}
+			}
+			
+			return false;
+		}
+};
+
+template <>
+class DistanceState<false> {
+	private:
+		static const int Stripes = 1024;
+		std::vector<std::atomic<WeightKey> > keys; // The distance key of every node
+		std::vector<NodeID> parents;                // The parent of every node
+		std::vector<std::atomic<bool> > locks;      // The locks guarding the parents, one per stripe of nodes
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	size: This is the amount of nodes
+		DistanceState(NodeID size) : keys(size), parents(size), locks(Stripes) {
+			for (int i = 0; i < Stripes; i++) {
+				locks[i].store(false);
+			}
+			
+			return;
+		}
+		
+		// Reset
+		// params:
+		//	node: This is the node to reset
+		// Marks the node unreached
+		void Reset(NodeID node) {
+			keys[node].store(~(WeightKey)0, std::memory_order_relaxed);
+			parents[node] = -1;
+			return;
+		}
+		
+		// GetKey
+		// params:
+		//	node: This is the node whose distance we want
+		// Returns the distance key of the node, all ones if it is unreached
+		WeightKey GetKey(NodeID node) const {
+			return keys[node].load(std::memory_order_relaxed);
+		}
+		
+		// GetParent
+		// params:
+		//	node: This is the node whose parent we want
+		// Returns the parent of the node, -1 if it has none
+		NodeID GetParent(NodeID node) const {
+			return parents[node];
+		}
+		
+		// Lower
+		// params:
+		//	node: This is the node to lower
+		//	key: This is the key of the new distance
+		//	parent: This is the node the new distance comes through
+		// Lowers the distance of the node if the key is strictly smaller,
+		// returns true if it was lowered
+		bool Lower(NodeID node, WeightKey key, NodeID parent) {
+			std::atomic<bool> & lock = locks[node % Stripes];
+			bool lowered = false;
+			
+			// Most relaxations lose, so check before taking the lock
+			if (key < keys[node].load(std::memory_order_relaxed)) {
+				while (lock.exchange(true, std::memory_order_acquire)) {
+				}
+				
+				if (key < keys[node].load(std::memory_order_relaxed)) {
+					keys[node].store(key, std::memory_order_relaxed);
+					parents[node] = parent;
+					lowered = true;
+				}
+				
+				lock.store(false, std::memory_order_release);
+			}
+			
+			return lowered;
+		}
+};
+
+// DeltaStepping
+// params:
+//	source: This is the node the search starts from
+//	delta: This is the width of each bucket, 0 picks one with GetAutoDelta
+//	threads: This is the amount of threads to use, 0 uses every core
+// Runs the delta-stepping single source shortest path algorithm and returns
+// the same distances as Dijkstra. Nodes are kept in buckets of width delta.
+// The nodes of the lowest bucket are settled together by all the threads,
+// first relaxing their light edges (no heavier than delta), which can refill
+// the bucket, until it stays empty, and then relaxing their heavy edges once.
+// The buckets are a cyclic array wide enough to reach past the heaviest
+// edge, so a thread holds a few of them whatever the distances. Only when
+// the weights are too spread out for that do nodes beyond the array wait
+// in an overflow list until their bucket comes in range.
+// When several shortest paths tie the parent may differ from Dijkstra. The
+// weights must not be negative.
+ShortestPathTree CsrGraph::DeltaStepping(NodeID source, Weight delta, int threads) const {
+	const uint64_t noBucket = ~(uint64_t)0, maxRing = 4096;
+	const WeightKey unreached = ~(WeightKey)0;
+	ShortestPathTree tree;
+	
+	// Every node starts out unreached
+	tree.source = source;
+	tree.distances.assign(vertices, InfiniteWeight);
+	tree.parents.assign(vertices, -1);
+	
+	// If the source is not in the graph there is nothing to search
+	if (!Contains(source)) {
+		return tree;
+	}
+	
+	if (!(delta > 0)) {
+		delta = GetAutoDelta();
+	}
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// Every nodes distance and parent change together
+	DistanceState<(sizeof(WeightKey) + sizeof(NodeID) <= sizeof(uint64_t))> state(vertices);
+	std::vector<NodeID> frontier(1, source);
+	std::vector<uint64_t> counts(threads), nexts(threads);
+	std::vector<Weight> heaviest(threads, 0);
+	std::atomic<uint64_t> cursor(0);
+	uint64_t frontierSize = 1, ring;
+	ThreadBarrier barrier(threads);
+	
+	// Size the cyclic array of buckets so no edge reaches past it
+	ParallelFor(0, edges, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			if (GetWeight(i) > heaviest[thread]) {
+				heaviest[thread] = GetWeight(i);
+			}
+		}
+	}, threads);
+	
+	double span = *std::max_element(heaviest.begin(), heaviest.end()) / (double)delta;
+	ring = (span < maxRing - 2 ? (uint64_t)span + 2 : maxRing);
+	
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			state.Reset(i);
+		}
+	}, threads);
+	state.Lower(source, WeightToKey(0), -1);
+	
+	ParallelThreads([&](int thread, int count) {
+		std::vector<std::vector<NodeID> > bins(ring);                // The nodes this thread put in each bucket in range
+		std::vector<std::pair<NodeID, uint64_t> > overflow;          // The nodes this thread put beyond the range, with their bucket
+		std::vector<NodeID> settled;                                 // The nodes this thread settled in the current bucket
+		uint64_t bucket = 0, overflowFirst = noBucket;
+		
+		// Relax
+		// Lowers the distance of the neighbor if going through the node is
+		// shorter and puts the neighbor in the bucket of its new distance
+		auto Relax = [&](NodeID node, Weight distance, EdgeIndex edge) {
+			NodeID neighbor = targets[edge];
+			Weight through = distance + GetWeight(edge);
+			
+			// If this is strictly shorter than what the neighbor has
+			if (neighbor != source && state.Lower(neighbor, WeightToKey(through), node)) {
+				uint64_t into = (uint64_t)(through / delta);
+				
+				// Rounding can not be allowed to wrap around the ring
+				if (into < bucket) {
+					into = bucket;
+				}
+				
+				if (into - bucket < ring) {
+					bins[into % ring].push_back(neighbor);
+				} else {
+					overflow.push_back(std::make_pair(neighbor, into));
+					
+					if (into < overflowFirst) {
+						overflowFirst = into;
+					}
+				}
+			}
+		};
+		
+		while (true) {
+			// Relax the light edges of the frontier, 64 nodes at a time
+			for (uint64_t first; (first = cursor.fetch_add(64)) < frontierSize; ) {
+				uint64_t last = (first + 64 < frontierSize ? first + 64 : frontierSize);
+				
+				for (uint64_t i = first; i < last; i++) {
+					NodeID node = frontier[i];
+					Weight distance = KeyToWeight(state.GetKey(node));
+					
+					// If the node has since moved to an earlier bucket it is already settled
+					if ((uint64_t)(distance / delta) != bucket) {
+						continue;
+					}
+					
+					settled.push_back(node);
+					
+					for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+						if (GetWeight(j) <= delta) {
+							Relax(node, distance, j);
+						}
+					}
+				}
+			}
+			
+			barrier.Wait();
+			
+			// If a light edge refilled the current bucket settle it again
+			counts[thread] = bins[bucket % ring].size();
+			barrier.Wait();
+			
+			uint64_t total = 0;
+			for (int i = 0; i < count; i++) {
+				total += counts[i];
+			}
+			
+			// Otherwise the bucket is done so relax the heavy edges of every
+			// node settled in it and move on to the next bucket with nodes in it
+			if (total == 0) {
+				for (uint64_t i = 0; i < settled.size(); i++) {
+					NodeID node = settled[i];
+					Weight distance = KeyToWeight(state.GetKey(node));
+					
+					for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+						if (GetWeight(j) > delta) {
+							Relax(node, distance, j);
+						}
+					}
+				}
+				
+				settled.clear();
+				
+				// Rounding can drop a heavy edge into the current bucket so start looking there
+				nexts[thread] = overflowFirst;
+				for (uint64_t i = bucket; i < bucket + ring && i < overflowFirst; i++) {
+					if (bins[i % ring].size() != 0) {
+						nexts[thread] = i;
+						break;
+					}
+				}
+				
+				barrier.Wait();
+				
+				bucket = noBucket;
+				for (int i = 0; i < count; i++) {
+					if (nexts[i] < bucket) {
+						bucket = nexts[i];
+					}
+				}
+				
+				// If every bucket is empty the search is done
+				if (bucket == noBucket) {
+					break;
+				}
+				
+				// Bring the waiting nodes whose buckets are now in range into the ring
+				if (overflowFirst - bucket < ring) {
+					uint64_t kept = 0;
+					
+					overflowFirst = noBucket;
+					for (uint64_t i = 0; i < overflow.size(); i++) {
+						if (overflow[i].second - bucket < ring) {
+							bins[overflow[i].second % ring].push_back(overflow[i].first);
+						} else {
+							overflow[kept++] = overflow[i];
+							
+							if (overflow[i].second < overflowFirst) {
+								overflowFirst = overflow[i].second;
+							}
+						}
+					}
+					
+					overflow.resize(kept);
+				}
+				
+				counts[thread] = bins[bucket % ring].size();
+				barrier.Wait();
+				
+				total = 0;
+				for (int i = 0; i < count; i++) {
+					total += counts[i];
+				}
+			}
+			
+			// Work out where this threads nodes go in the next frontier
+			uint64_t offset = 0;
+			for (int i = 0; i < thread; i++) {
+				offset += counts[i];
+			}
+			
+			if (thread == 0) {
+				if (frontier.size() < total) {
+					frontier.resize(total);
+				}
+				
+				frontierSize = total;
+				cursor.store(0);
+			}
+			
+			barrier.Wait();
+			
+			// Gather every threads nodes in the bucket into the frontier
+			std::copy(bins[bucket % ring].begin(), bins[bucket % ring].end(), frontier.begin() + offset);
+			bins[bucket % ring].clear();
+			
+			barrier.Wait();
+		}
+	}, threads);
+	
+	// Unpack the distances and parents
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			WeightKey key = state.GetKey(i);
+			
+			if (key != unreached) {
+				tree.distances[i] = KeyToWeight(key);
+				tree.parents[i] = state.GetParent(i);
+			}
+		}
+	}, threads);
+	
+	return tree;
+}
+
+// BreadthFirstSearch
+// params:
+//	source: This is the node the search starts from
+//	incoming: This is the Transpose of the graph, NULL if the graph is undirected
+//	threads: This is the amount of threads to use, 0 uses every core
+// Runs a direction optimizing breadth first search and returns the level
+// and parent of every node. While the frontier is small it steps top down,
+// checking the edges out of every frontier node. Once the edges out of the
+// frontier outnumber a fifteenth of the edges left to check it steps bottom
+// up instead, where every unvisited node looks through its incoming edges for
+// a parent in the frontier and stops at the first one. The frontier is a queue
+// top down and a bitmap bottom up. When several parents are one hop away the
+// parent may differ between runs.
+BreadthFirstTree CsrGraph::BreadthFirstSearch(NodeID source, const CsrGraph * incoming, int threads) const {
+	const int alpha = 15, beta = 18;
+	BreadthFirstTree tree;
+	
+	// Every node starts out unreached
+	tree.source = source;
+	tree.levels.assign(vertices, -1);
+	tree.parents.assign(vertices, -1);
+	
+	// If the source is not in the graph there is nothing to search
+	if (!Contains(source)) {
+		return tree;
+	}
+	
+	if (incoming == NULL) {
+		incoming = this;
+	}
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// The parents double as the visited set, a node is visited once a
+	// thread has swapped its parent away from -1
+	std::vector<std::atomic<NodeID> > parents(vertices);
+	std::vector<std::vector<NodeID> > found(threads);
+	std::vector<NodeID> queue(1, source);
+	std::vector<std::atomic<uint64_t> > front((vertices + 63) / 64), next((vertices + 63) / 64);
+	std::vector<EdgeIndex> scouts(threads), awake(threads);
+	EdgeIndex edgesToCheck = edges, scout = GetDegree(source);
+	int level = 0;
+	
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			parents[i].store(-1, std::memory_order_relaxed);
+		}
+	}, threads);
+	
+	parents[source].store(source);
+	tree.levels[source] = 0;
+	
+	// While there are nodes in the frontier
+	while (queue.size() > 0) {
+		// If the frontier has grown big step bottom up until it shrinks again
+		if (scout > edgesToCheck / alpha) {
+			EdgeIndex awakeCount = queue.size(), lastAwake;
+			
+			// Turn the queue into a bitmap
+			ParallelFor(0, front.size(), [&](int thread, uint64_t first, uint64_t last) {
+				for (uint64_t i = first; i < last; i++) {
+					front[i].store(0, std::memory_order_relaxed);
+				}
+			}, threads);
+			
+			ParallelFor(0, queue.size(), [&](int thread, uint64_t first, uint64_t last) {
+				for (uint64_t i = first; i < last; i++) {
+					front[queue[i] / 64].fetch_or((uint64_t)1 << (queue[i] % 64), std::memory_order_relaxed);
+				}
+			}, threads);
+			
+			do {
+				lastAwake = awakeCount;
+				level++;
+				
+				// Every unvisited node looks for a parent in the frontier
+				ParallelFor(0, next.size(), [&](int thread, uint64_t first, uint64_t last) {
+					EdgeIndex count = 0;
+					
+					// Each thread owns whole words of the next bitmap
+					for (uint64_t word = first; word < last; word++) {
+						uint64_t bits = 0;
+						
+						for (NodeID node = word * 64; node < vertices && node < (NodeID)(word * 64 + 64); node++) {
+							if (parents[node].load(std::memory_order_relaxed) != -1) {
+								continue;
+							}
+							
+							for (EdgeIndex j = incoming->offsets[node]; j < incoming->offsets[node + 1]; j++) {
+								NodeID neighbor = incoming->targets[j];
+								
+								// If the neighbor is in the frontier it is the parent
+								if (front[neighbor / 64].load(std::memory_order_relaxed) & ((uint64_t)1 << (neighbor % 64))) {
+									parents[node].store(neighbor, std::memory_order_relaxed);
+									tree.levels[node] = level;
+									bits |= (uint64_t)1 << (node % 64);
+									count++;
+									break;
+								}
+							}
+						}
+						
+						next[word].store(bits, std::memory_order_relaxed);
+					}
+					
+					awake[thread] = count;
+				}, threads);
+				
+				// The next frontier becomes the current one
+				awakeCount = 0;
+				for (int i = 0; i < threads; i++) {
+					awakeCount += awake[i];
+					awake[i] = 0;
+				}
+				
+				front.swap(next);
+			} while (awakeCount >= lastAwake || awakeCount > (EdgeIndex)vertices / beta);
+			
+			// Turn the bitmap back into a queue
+			ParallelFor(0, front.size(), [&](int thread, uint64_t first, uint64_t last) {
+				for (uint64_t word = first; word < last; word++) {
+					uint64_t bits = front[word].load(std::memory_order_relaxed);
+					
+					for (int bit = 0; bits != 0 && bit < 64; bit++) {
+						if ((bits >> bit) & 1) {
+							found[thread].push_back(word * 64 + bit);
+						}
+					}
+				}
+			}, threads);
+			
+			scout = 1;
+		} else {
+			level++;
+			
+			// Every frontier node claims its unvisited neighbors
+			ParallelFor(0, queue.size(), [&](int thread, uint64_t first, uint64_t last) {
+				EdgeIndex count = 0;
+				
+				for (uint64_t i = first; i < last; i++) {
+					NodeID node = queue[i];
+					
+					for (EdgeIndex j = offsets[node]; j < offsets[node + 1]; j++) {
+						NodeID neighbor = targets[j], unclaimed = -1;
+						
+						// If this thread is the one that claims the neighbor
+						if (parents[neighbor].load(std::memory_order_relaxed) == -1 &&
+							parents[neighbor].compare_exchange_strong(unclaimed, node)) {
+							tree.levels[neighbor] = level;
+							found[thread].push_back(neighbor);
+							count += offsets[neighbor + 1] - offsets[neighbor];
+						}
+					}
+				}
+				
+				scouts[thread] = count;
+			}, threads);
+			
+			edgesToCheck -= scout;
+			scout = 0;
+			for (int i = 0; i < threads; i++) {
+				scout += scouts[i];
+				scouts[i] = 0;
+			}
+		}
+		
+		// Gather the nodes every thread found into the next queue
+		queue.clear();
+		for (int i = 0; i < threads; i++) {
+			queue.insert(queue.end(), found[i].begin(), found[i].end());
+			found[i].clear();
+		}
+	}
+	
+	// Copy out the parents, the source has none
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			tree.parents[i] = parents[i].load(std::memory_order_relaxed);
+		}
+	}, threads);
+	tree.parents[source] = -1;
+	
+	return tree;
+}
+
+// ConnectedComponents
+// params:
+//	incoming: This is the Transpose of the graph, it can be left NULL when
+//	          the graph is undirected
+//	threads: This is the amount of threads to use, 0 uses every core
+// Labels every node with its weakly connected component using the Afforest
+// algorithm on a ConcurrentUnionFind. Every node is first linked to its first
+// couple of neighbors, which is usually enough to join most of the biggest
+// component. A sample of nodes then finds that component and the rest of the
+// edges are only linked for nodes outside of it. Returns the label of every
+// node, which is the smallest node ID in its component.
+std::vector<NodeID> CsrGraph::ConnectedComponents(const CsrGraph * incoming, int threads) const {
+	const int neighborRounds = 2, samples = 1024;
+	ConcurrentUnionFind sets(vertices);
+	std::vector<NodeID> labels(vertices);
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// Link every node to its first few neighbors, one neighbor at a time
+	for (int round = 0; round < neighborRounds; round++) {
+		ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				if (offsets[i] + round < offsets[i + 1]) {
+					sets.Union(i, targets[offsets[i] + round]);
+				}
+			}
+		}, threads);
+	}
+	
+	// Find the most common root in a sample of the nodes, it is very
+	// likely the root of the biggest component
+	NodeID giant = -1;
+	
+	if (vertices > 0) {
+		std::mt19937 random(vertices);
+		std::vector<NodeID> roots(samples);
+		int run = 0, best = 0;
+		
+		for (int i = 0; i < samples; i++) {
+			roots[i] = sets.Find(random() % vertices);
+		}
+		
+		std::sort(roots.begin(), roots.end());
+		
+		for (int i = 0; i < samples; i++) {
+			run = (i > 0 && roots[i] == roots[i - 1] ? run + 1 : 1);
+			
+			if (run > best) {
+				best = run;
+				giant = roots[i];
+			}
+		}
+	}
+	
+	// Link the rest of the edges of every node outside the biggest component.
+	// An edge from the biggest component to a node outside of it is picked up
+	// from the other end, through the incoming edges when it is directed.
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			if (sets.Find(i) == giant) {
+				continue;
+			}
+			
+			for (EdgeIndex j = offsets[i] + neighborRounds; j < offsets[i + 1]; j++) {
+				sets.Union(i, targets[j]);
+			}
+			
+			if (incoming != NULL) {
+				for (EdgeIndex j = incoming->offsets[i]; j < incoming->offsets[i + 1]; j++) {
+					sets.Union(i, incoming->targets[j]);
+				}
+			}
+		}
+	}, threads);
+	
+	// Label every node with its root
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			labels[i] = sets.Find(i);
+		}
+	}, threads);
+	
+	return labels;
+}
+
+// Print
+// Prints the adjacency list of this graph
+void CsrGraph::Print() const {
+	// For every node in the graph
+	for (NodeID i = 0; i < GetNumVertices(); i++) {
+		// Print the nodes ID
+		std::cout << i;
+		
+		// For every edge leaving the node
+		for (EdgeIndex j = offsets[i]; j < offsets[i + 1]; j++) {
+			// Print the edges information
+			std::cout << " - ";
+			Edge(i, targets[j], GetWeight(j)).Print();
+		}
+		
+		// Move to the next line
+		std::cout << std::endl;
+	}
+	
+	return;
+}
\ No newline at end of file
@@ -0,0 +1,362 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector> // For the vector class
+#include <string> // For the string class
+#include <memory> // For the shared_ptr class
+#include <stdint.h> // For the fixed width integer types
+#include "Node.h" // For the Node and Edge classes
+#include "MappedFile.h" // For the MappedFile class
+#include "ConcurrentUnionFind.h" // For the ConcurrentUnionFind class
+#include "ShortestPathTree.h" // For the ShortestPathTree struct
+#include "BreadthFirstTree.h" // For the BreadthFirstTree struct
+#include "SpanningForest.h" // For the SpanningForest struct
+
+typedef uint64_t EdgeIndex;
+
+// CsrGraph
+// This is an immutable, compressed sparse row snapshot of a graph. The
+// neighbors of every node are packed into contiguous offset, target and
+// weight arrays so traversals do not chase a pointer per vertex. It is
+// created with Graph::Freeze() and all algorithms can run on it directly.
+// The neighbors of every node are kept sorted by ID.
+// A snapshot can be saved to a binary file and mapped back in with Load,
+// in which case the arrays point straight into the mapped file.
+class CsrGraph {
+	private:
+		// The arrays every algorithm reads, they point either into the
+		// storage vectors below or into a mapped file
+		const EdgeIndex * offsets; // The start of each nodes neighbors, size V + 1
+		const NodeID * targets;    // The end node of every edge
+		const Weight * weights;    // The weight of every edge, NULL when unweighted
+		NodeID vertices;           // This is the number of vertices
+		EdgeIndex edges;           // This is the number of edges
+		
+		// The arrays of a snapshot built in memory
+		std::vector<EdgeIndex> offsetStorage;
+		std::vector<NodeID> targetStorage;
+		std::vector<Weight> weightStorage;
+		
+		// The file a loaded snapshot is mapped from, shared between copies
+		std::shared_ptr<MappedFile> mapping;
+		
+		// FileHeader
+		// This is the header at the start of a saved graph file. Every array
+		// follows it at the given byte position, aligned to eight bytes.
+		struct FileHeader {
+			char magic[8];          // Always "CPPGRAPH"
+			uint32_t version;       // The version of the file format
+			uint32_t byteOrder;     // Always 0x01020304 in the writers byte order
+			uint32_t nodeIDSize;    // The size of a NodeID in bytes
+			uint32_t weightSize;    // The size of a weight in bytes, 0 when unweighted
+			uint64_t vertices;      // The number of vertices
+			uint64_t edges;         // The number of edges
+			uint64_t offsetsPos;    // The byte position of the offsets array
+			uint64_t targetsPos;    // The byte position of the targets array
+			uint64_t weightsPos;    // The byte position of the weights array
+		};
+		
+		// FileVersion
+		// This is the version of the file format written by Save
+		static const uint32_t FileVersion = 1;
+		
+		// BindStorage
+		// Points the arrays at the storage vectors once they have been filled
+		void BindStorage();
+		
+		// GatherEdges
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Gathers one copy of every edge ordered by start then end node. An
+		// edge whose reverse is at least as light is left out, so undirected
+		// edges appear once while the lightest direction of a pair of
+		// directed edges is always kept.
+		EdgeList GatherEdges(int threads = 0) const;
+		
+		// GetSortedEdges
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Gathers one copy of every edge and sorts them by weight. Edges of the
+		// same weight stay ordered by start then end node, which is KruskalOrder.
+		EdgeList GetSortedEdges(int threads = 0) const;
+		
+		// KruskalOrder
+		// params:
+		//	one: This is the first edge
+		//	two: This is the second edge
+		// Returns true if the first edge comes before the second in the order
+		// Kruskals Algorithm takes them in, by weight then start then end node.
+		// Every MST algorithm breaks ties this way so they all build the same forest.
+		static bool KruskalOrder(const Edge & one, const Edge & two);
+		
+		// FilterKruskal
+		// params:
+		//	e: This is the list of edges being worked on
+		//	buffer: This is scratch space as big as the edge list
+		//	first: This is the first edge of the range to add
+		//	last: This is one past the last edge of the range to add
+		//	sets: This tracks which nodes the forest already connects
+		//	forest: This is the forest being built
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Adds the edges of the range to the forest in KruskalOrder, splitting
+		// big ranges around a pivot and filtering out heavy edges that would
+		// close a cycle before they are ever sorted
+		void FilterKruskal(EdgeList & e, EdgeList & buffer, EdgeIndex first, EdgeIndex last, ConcurrentUnionFind & sets, SpanningForest & forest, int threads) const;
+		
+		// RunPrims
+		// params:
+		//	start: This is the starting node for the produced MSF
+		//	parents: This is filled with the parent of every node in the MSF
+		//	forest: This is added every forest edge as it is taken if it is not NULL
+		// Runs Prim's Algorithm and returns the weight of the MSF
+		Weight RunPrims(NodeID start, std::vector<NodeID> & parents, SpanningForest * forest) const;
+		
+		// IsCanonical
+		// params:
+		//	node: This is the node the edge leaves
+		//	edge: This is the index of the edge
+		// Returns true if the edge is the copy GatherEdges keeps, which is
+		// every edge to a higher ID and any edge whose reverse is heavier or missing
+		bool IsCanonical(NodeID node, EdgeIndex edge) const;
+		
+		// RunDijkstra
+		// params:
+		//	source: This is the node the search starts from
+		//	target: This is the node the search stops at, -1 to search everything
+		//	queue: This is the priority queue to run on
+		//	tree: This is filled with the distances and parents
+		// Runs Dijkstras Algorithm from the source until the target is settled
+		// or every reachable node is
+		template <class Queue>
+		void RunDijkstra(NodeID source, NodeID target, Queue & queue, ShortestPathTree & tree) const;
+		
+		friend class Graph;
+		friend class GraphBuilder;
+		friend class PathQuery;
+	
+	public:
+		// Default constructor
+		// Creates an empty graph with no vertices
+		CsrGraph();
+		
+		// Copy Constructor
+		// params:
+		//	graph: This is the graph we wish to copy
+		// Copies the graph, a mapped graph shares the mapping
+		CsrGraph(const CsrGraph & graph);
+		
+		// operator= Overload
+		// params:
+		//	graph: This is the graph we wish to copy
+		// Copies the graph, a mapped graph shares the mapping
+		CsrGraph & operator=(const CsrGraph & graph);
+		
+		// Save
+		// params:
+		//	path: This is the path of the file to write
+		// Writes the graph to a binary file that Load can map back in,
+		// returns true if the file was written
+		bool Save(const std::string & path) const;
+		
+		// Load
+		// params:
+		//	path: This is the path of the file to read
+		//	verify: Is a flag if every offset and target is checked
+		// Maps a file written by Save and uses it as this graph without
+		// reading or copying it. Only the header and sizes are checked, so
+		// the contents are trusted. Verifying reads the offsets and targets
+		// through once to check they stay in bounds, for files that may be
+		// corrupt. Returns false and leaves the graph as it was if the file
+		// is missing or is not a valid graph file.
+		bool Load(const std::string & path, bool verify = false);
+		
+		// IsMapped
+		// Returns true if the graph is backed by a mapped file
+		bool IsMapped() const;
+		
+		// GetNumVertices
+		// Returns the number of vertices in the graph
+		NodeID GetNumVertices() const;
+		
+		// GetNumEdges
+		// Returns the number of edges in the graph
+		EdgeIndex GetNumEdges() const;
+		
+		// GetBegin
+		// params:
+		//	node: This is the node whose neighbors we want
+		// Returns the index of the first edge leaving the node
+		EdgeIndex GetBegin(NodeID node) const;
+		
+		// GetEnd
+		// params:
+		//	node: This is the node whose neighbors we want
+		// Returns one past the index of the last edge leaving the node
+		EdgeIndex GetEnd(NodeID node) const;
+		
+		// GetDegree
+		// params:
+		//	node: This is the node whose degree we want
+		// Returns the number of edges leaving the node
+		EdgeIndex GetDegree(NodeID node) const;
+		
+		// GetTarget
+		// params:
+		//	edge: This is the index of the edge
+		// Returns the end node ID of the edge
+		NodeID GetTarget(EdgeIndex edge) const;
+		
+		// GetWeight
+		// params:
+		//	edge: This is the index of the edge
+		// Returns the weight associated with the edge, always 1 when the
+		// library is built with CPPGRAPH_UNWEIGHTED
+		Weight GetWeight(EdgeIndex edge) const;
+		
+		// Contains
+		// params:
+		//	node: This is the node we are looking for
+		// Returns true if the graph contains the node, false otherwise
+		bool Contains(NodeID node) const;
+		
+		// Transpose
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Returns a snapshot with every edge reversed, so the neighbors of a node
+		// are the nodes with an edge into it. The neighbors stay sorted by ID.
+		CsrGraph Transpose(int threads = 0) const;
+		
+		// FindEdge
+		// params:
+		//	startID: This is the node id of the starting node
+		//	endID: This is the node id of the ending node
+		// Returns the index of the edge from the start to the end node,
+		// GetNumEdges() if there is no such edge
+		EdgeIndex FindEdge(NodeID startID, NodeID endID) const;
+		
+		// PrimsAlgorithm
+		// params:
+		//	start: This is the starting node for the produced MSF
+		// Runs Prim's Algorithm on the graph and returns the produced MSF
+		AdjList PrimsAlgorithm(NodeID start = 0) const;
+		
+		// PrimsAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the produced MSF
+		//	start: This is the starting node for the produced MSF
+		// Runs Prim's Algorithm on the graph, every forest edge goes from the
+		// node already in the tree to the node it brought in
+		void PrimsAlgorithm(SpanningForest & forest, NodeID start = 0) const;
+		
+		// PrimsAlgorithm
+		// params:
+		//	parents: This is filled with the parent of every node in the MSF
+		//	start: This is the starting node for the produced MSF
+		// Runs Prim's Algorithm on the graph and returns the weight of the
+		// MSF. The root of every tree is its own parent. This is the smallest
+		// form of the result, one ID per node.
+		Weight PrimsAlgorithm(std::vector<NodeID> & parents, NodeID start = 0) const;
+		
+		// KruskalsAlgorithm
+		// Performs Kruskals Algorithm on the graph and returns an
+		// adjacency list that makes a MSF
+		AdjList KruskalsAlgorithm() const;
+		
+		// KruskalsAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		// Performs Kruskals Algorithm on the graph
+		void KruskalsAlgorithm(SpanningForest & forest) const;
+		
+		// FilterKruskalAlgorithm
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs the Filter-Kruskal Algorithm on the graph and returns the same
+		// MSF as KruskalsAlgorithm. The partitioning and filtering run in parallel.
+		AdjList FilterKruskalAlgorithm(int threads = 0) const;
+		
+		// FilterKruskalAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs the Filter-Kruskal Algorithm on the graph and finds the same
+		// MSF as KruskalsAlgorithm
+		void FilterKruskalAlgorithm(SpanningForest & forest, int threads = 0) const;
+		
+		// BoruvkaAlgorithm
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs Boruvkas Algorithm on the graph and returns the same MSF as
+		// KruskalsAlgorithm. The lightest edge out of every component is found
+		// in parallel each round and the components are contracted along them.
+		AdjList BoruvkaAlgorithm(int threads = 0) const;
+		
+		// BoruvkaAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs Boruvkas Algorithm on the graph and finds the same MSF as
+		// KruskalsAlgorithm
+		void BoruvkaAlgorithm(SpanningForest & forest, int threads = 0) const;
+		
+		// Dijkstra
+		// params:
+		//	source: This is the node the search starts from
+		//	queue: This is the priority queue to run on, defaulted to the IndexedHeap
+		// Runs Dijkstras Algorithm from the source and returns the distance to
+		// and parent of every node. The weights must not be negative.
+		ShortestPathTree Dijkstra(NodeID source, ShortestPathQueue queue = IndexedHeapQueue) const;
+		
+		// Dijkstra
+		// params:
+		//	source: This is the node the search starts from
+		//	target: This is the node the search stops at
+		//	queue: This is the priority queue to run on, defaulted to the IndexedHeap
+		// Runs Dijkstras Algorithm from the source and stops as soon as the target
+		// is settled. The distance and path to the target are final, the other
+		// nodes only hold what the search had found so far.
+		ShortestPathTree Dijkstra(NodeID source, NodeID target, ShortestPathQueue queue = IndexedHeapQueue) const;
+		
+		// GetAutoDelta
+		// Picks a bucket width for DeltaStepping from the edge weights, about
+		// the largest weight over the average degree but never below the
+		// lightest positive weight
+		Weight GetAutoDelta() const;
+		
+		// DeltaStepping
+		// params:
+		//	source: This is the node the search starts from
+		//	delta: This is the width of each bucket, 0 picks one with GetAutoDelta
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Runs the parallel delta-stepping shortest path algorithm and returns
+		// the same distances as Dijkstra. When several shortest paths tie the
+		// parent may differ from Dijkstra. The weights must not be negative.
+		ShortestPathTree DeltaStepping(NodeID source, Weight delta = 0, int threads = 0) const;
+		
+		// BreadthFirstSearch
+		// params:
+		//	source: This is the node the search starts from
+		//	incoming: This is the Transpose of the graph, it can be left NULL
+		//	          when the graph is undirected
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Runs a direction optimizing breadth first search, stepping top down
+		// while the frontier is small and bottom up through the incoming edges
+		// while it is big. Returns the level and parent of every node.
+		BreadthFirstTree BreadthFirstSearch(NodeID source, const CsrGraph * incoming = NULL, int threads = 0) const;
+		
+		// ConnectedComponents
+		// params:
+		//	incoming: This is the Transpose of the graph, it can be left NULL
+		//	          when the graph is undirected
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Labels every node with its weakly connected component using the
+		// parallel Afforest algorithm. Returns the label of every node, which
+		// is the smallest node ID in its component.
+		std::vector<NodeID> ConnectedComponents(const CsrGraph * incoming = NULL, int threads = 0) const;
+		
+		// Print
+		// Prints the adjacency list of this graph
+		void Print() const;
+}; // End CsrGraph Class
+
+#endif
\ No newline at end of file
@@ -9,9 +9,15 @@ Edge::Edge() {
 // params:
 //	endID: This is the id associated with the node at the end of the LinkedList
 //	weight: This is the weight for the given link
-Edge::Edge(NodeID startID, NodeID endID, float weight) : startID(startID), endID(endID), weight(weight) {
+#ifdef CPPGRAPH_UNWEIGHTED
+Edge::Edge(NodeID startID, NodeID endID, Weight weight) : startID(startID), endID(endID) {
 	return;
 }
+#else
+Edge::Edge(NodeID startID, NodeID endID, Weight weight) : startID(startID), endID(endID), weight(weight) {
+	return;
+}
+#endif
 
 // GetStartID
 // Returns the start node ID of this edge
@@ -27,15 +33,19 @@ NodeID Edge::GetID() const {
 
 // GetWeight
 // Returns the weight associated with this edge
-float Edge::GetWeight() const {
+Weight Edge::GetWeight() const {
+#ifdef CPPGRAPH_UNWEIGHTED
+	return 1;
+#else
 	return weight;
+#endif
 }
 
 // Print
 // Prints the edges data in the format:
 // endID(weight)
 void Edge::Print() const {
-	std::cout << "(" << startID << ", " << endID << " (wght: " << weight << "))";
+	std::cout << "(" << startID << ", " << endID << " (wght: " << GetWeight() << "))";
 	return;
 }
 
@@ -44,7 +54,7 @@ void Edge::Print() const {
 //	edge: This is the edge we are comapring against
 // Performs a less than check between this and the passed edge
 bool Edge::operator < (const Edge & edge) const {
-	return (weight < edge.weight);
+	return (GetWeight() < edge.GetWeight());
 }
 
 // Operator <= Overload
@@ -52,7 +62,7 @@ bool Edge::operator < (const Edge & edge) const {
 //	edge: This is the edge we are comapring against
 // Performs a less than or equal to check between this and the passed edge
 bool Edge::operator <= (const Edge & edge) const {
-	return (weight <= edge.weight);
+	return (GetWeight() <= edge.GetWeight());
 }
 
 // Operator > Overload
@@ -60,7 +70,7 @@ bool Edge::operator <= (const Edge & edge) const {
 //	edge: This is the edge we are comapring against
 // Performs a greater than check between this and the passed edge
 bool Edge::operator > (const Edge & edge) const {
-	return (weight > edge.weight);
+	return (GetWeight() > edge.GetWeight());
 }
 
 // Operator >= Overload
@@ -68,7 +78,7 @@ bool Edge::operator > (const Edge & edge) const {
 //	edge: This is the edge we are comapring against
 // Performs a greater than or equal to check between this and the passed edge
 bool Edge::operator >= (const Edge & edge) const {
-	return (weight >= edge.weight);
+	return (GetWeight() >= edge.GetWeight());
 }
 
 // Operator == Overload
@@ -78,7 +88,7 @@ bool Edge::operator >= (const Edge & edge) const {
 bool Edge::operator == (const Edge & edge) const {
 	return (startID == edge.startID && 
 			endID == edge.endID && 
-			weight == edge.weight);
+			GetWeight() == edge.GetWeight());
 }
 
 // Operator != Overload
@@ -88,5 +98,5 @@ bool Edge::operator == (const Edge & edge) const {
 bool Edge::operator != (const Edge & edge) const {
 	return (startID != edge.startID || 
 			endID != edge.endID || 
-			weight != edge.weight);
+			GetWeight() != edge.GetWeight());
 }
\ No newline at end of file
@@ -1,7 +1,43 @@
 #ifndef EDGE_H
 #define EDGE_H
 
+#include <stdint.h> // For the fixed width integer types
+#include <limits> // For the numeric_limits class
+
+// NodeID
+// This is the type of every node ID. It is an int unless the build defines
+// CPPGRAPH_64BIT_IDS, then it is 64 bits wide so a graph can hold more than
+// two billion nodes. IDs stay signed so -1 can mark a missing node.
+#ifdef CPPGRAPH_64BIT_IDS
+typedef int64_t NodeID;
+#else
 typedef int NodeID;
+#endif
+
+// Weight
+// This is the type of every edge weight and path length. It is a float
+// unless the build defines CPPGRAPH_WEIGHT as another type, which can be
+// double or an integer type of up to 64 bits.
+#ifdef CPPGRAPH_WEIGHT
+typedef CPPGRAPH_WEIGHT Weight;
+#else
+typedef float Weight;
+#endif
+
+// InfiniteWeight
+// This is the length of a path that does not exist, infinity for floating
+// point weights and the largest value for integer weights
+const Weight InfiniteWeight = (std::numeric_limits<Weight>::has_infinity ? std::numeric_limits<Weight>::infinity() : std::numeric_limits<Weight>::max());
+
+// WeightedEdges
+// This is false when the build defines CPPGRAPH_UNWEIGHTED. Edges then store
+// no weight at all and every edge weighs 1, so unweighted graphs do not pay
+// for a weight per edge. Weights passed in are ignored.
+#ifdef CPPGRAPH_UNWEIGHTED
+const bool WeightedEdges = false;
+#else
+const bool WeightedEdges = true;
+#endif
 
 // Edge
 // This class represents a weight link between two nodes
@@ -9,7 +45,9 @@ class Edge {
 	private:
 		// instance variables
 		NodeID startID, endID;
-		float weight;
+#ifndef CPPGRAPH_UNWEIGHTED
+		Weight weight;
+#endif
 		
 		// Default constructor
 		Edge();
@@ -19,7 +57,7 @@ class Edge {
 		// params:
 		//	endID: This is the id associated with the node at the end of the LinkedList
 		//	weight: This is the weight for the given link
-		Edge(NodeID startID, NodeID endID, float weight = 0);
+		Edge(NodeID startID, NodeID endID, Weight weight = 0);
 		
 		// GetStartID
 		// Returns the start node ID of this edge
@@ -31,7 +69,7 @@ class Edge {
 		
 		// GetWeight
 		// Returns the weight associated with this edge
-		float GetWeight() const;
+		Weight GetWeight() const;
 		
 		// Print
 		// Prints the edges data in the format:
@@ -0,0 +1,189 @@
+#include <stdint.h> // For the uintptr_t type
+#include "EdgeArena.h"
+
+const int EdgeArena::Classes;
+const std::size_t EdgeArena::MinBlock;
+const std::size_t EdgeArena::DefaultChunkSize;
+
+// Parameterized Constructor
+// params:
+//	chunkSize: This is the size of every chunk the arena allocates
+// Creates an arena that allocates its own chunks
+EdgeArena::EdgeArena(std::size_t chunkSize) : region(NULL), regionSize(0), chunkSize(chunkSize < MinBlock ? MinBlock : chunkSize) {
+	Reset();
+	return;
+}
+
+// Destructor
+// Releases every chunk the arena allocated
+EdgeArena::~EdgeArena() {
+	for (std::size_t i = 0; i < chunks.size(); i++) {
+		::operator delete(chunks[i]);
+	}
+	
+	return;
+}
+
+// GetClass
+// params:
+//	bytes: This is the size of the block wanted
+// Returns the smallest block size class that holds the bytes
+int EdgeArena::GetClass(std::size_t bytes) {
+	int sizeClass = 0;
+	
+	while (sizeClass < Classes - 1 && (MinBlock << sizeClass) < bytes) {
+		sizeClass++;
+	}
+	
+	return sizeClass;
+}
+
+// Reset
+// Empties the free lists and starts carving from the callers region
+void EdgeArena::Reset() {
+	for (int i = 0; i < Classes; i++) {
+		freeLists[i] = NULL;
+	}
+	
+	// Start the region on a block boundary
+	if (region != NULL) {
+		uintptr_t start = ((uintptr_t)region + MinBlock - 1) & ~(uintptr_t)(MinBlock - 1);
+		
+		cursor = (char *)start;
+		limit = region + regionSize;
+		
+		if (cursor > limit) {
+			cursor = limit;
+		}
+	} else {
+		cursor = NULL;
+		limit = NULL;
+	}
+	
+	used = 0;
+	releasing = false;
+	
+	return;
+}
+
+// UseRegion
+// params:
+//	region: This is the start of the memory to use, NULL for none
+//	size: This is the size of the memory in bytes
+// Hands out blocks from the callers memory before allocating any
+// chunks. Returns false if the arena has blocks out.
+bool EdgeArena::UseRegion(void * region, std::size_t size) {
+	bool placed = false;
+	
+	// If nothing has been handed out yet
+	if (used == 0) {
+		this->region = (char *)region;
+		this->regionSize = (region != NULL ? size : 0);
+		Release();
+		
+		placed = true;
+	}
+	
+	return placed;
+}
+
+// Allocate
+// params:
+//	bytes: This is the size of the block wanted
+// Returns a block of at least the bytes, aligned to 16 bytes
+void * EdgeArena::Allocate(std::size_t bytes) {
+	int sizeClass = GetClass(bytes);
+	std::size_t size = MinBlock << sizeClass;
+	void * block = NULL;
+	
+	// If no size class is big enough there is no block to give
+	if (size < bytes) {
+		throw std::bad_alloc();
+	}
+	
+	// If a block of this size was freed reuse it
+	if (freeLists[sizeClass] != NULL) {
+		block = freeLists[sizeClass];
+		freeLists[sizeClass] = freeLists[sizeClass]->next;
+		
+	// If the block is bigger than a chunk give it a chunk of its own
+	} else if (size > chunkSize) {
+		chunks.push_back((char *)::operator new(size));
+		block = chunks.back();
+	} else {
+		// If the current chunk is too full start a new one
+		if ((std::size_t)(limit - cursor) < size) {
+			// Hand the tail of the current chunk to the free lists rather
+			// than waste it, largest blocks first
+			for (int i = Classes - 1; i >= 0; i--) {
+				while ((std::size_t)(limit - cursor) >= (MinBlock << i)) {
+					FreeBlock * tail = (FreeBlock *)cursor;
+					
+					tail->next = freeLists[i];
+					freeLists[i] = tail;
+					cursor += (MinBlock << i);
+				}
+			}
+			
+			chunks.push_back((char *)::operator new(chunkSize));
+			cursor = chunks.back();
+			limit = cursor + chunkSize;
+		}
+		
+		block = cursor;
+		cursor += size;
+	}
+	
+	used += size;
+	
+	return block;
+}
+
+// Deallocate
+// params:
+//	block: This is a block made by Allocate
+//	bytes: This is the size the block was allocated with
+// Puts the block on the free list for its size
+void EdgeArena::Deallocate(void * block, std::size_t bytes) {
+	// If the whole arena is about to be released there is nothing to do
+	if (releasing || block == NULL) {
+		return;
+	}
+	
+	int sizeClass = GetClass(bytes);
+	FreeBlock * freed = (FreeBlock *)block;
+	
+	freed->next = freeLists[sizeClass];
+	freeLists[sizeClass] = freed;
+	used -= (MinBlock << sizeClass);
+	
+	return;
+}
+
+// BeginRelease
+// Ignores every Deallocate until Release, so the containers holding
+// the blocks can be destroyed without handing them back one by one
+void EdgeArena::BeginRelease() {
+	releasing = true;
+	return;
+}
+
+// Release
+// Drops every block at once. The chunks the arena allocated are freed
+// and the callers region is used again from its start.
+void EdgeArena::Release() {
+	for (std::size_t i = 0; i < chunks.size(); i++) {
+		::operator delete(chunks[i]);
+	}
+	
+	std::vector<char *>().swap(chunks);
+	Reset();
+	
+	return;
+}
+
+// GetUsedBytes
+// Returns the amount of bytes in the blocks handed out
+std::size_t EdgeArena::GetUsedBytes() const {
+	return used;
+}
@@ -0,0 +1,182 @@
+#ifndef EDGE_ARENA_H
+#define EDGE_ARENA_H
+
+#include <cstddef> // For NULL and the size_t type
+#include <new> // For operator new and operator delete
+#include <vector> // For the vector class
+
+// EdgeArena
+// This is a slab allocator for the adjacency arrays of a graphs nodes.
+// Blocks are rounded up to a power of two and carved out of large chunks,
+// and freed blocks go on a free list for their size so the next array of
+// that size reuses them. Release drops every block at once instead of one
+// free per array. The memory can come from a region the caller owns, such
+// as huge pages, and once it runs out the arena carries on in chunks of
+// its own. The arena is not thread safe.
+class EdgeArena {
+	private:
+		// FreeBlock
+		// This is the link written into a block while it is on a free list
+		struct FreeBlock {
+			FreeBlock * next;
+		};
+		
+		static const int Classes = 48;          // The amount of block sizes
+		static const std::size_t MinBlock = 16; // The size of the smallest block
+		
+		FreeBlock * freeLists[Classes]; // The freed blocks of every size
+		std::vector<char *> chunks;     // The chunks the arena allocated itself
+		char * region;                  // The start of the callers region, NULL if there is none
+		std::size_t regionSize;         // The size of the callers region in bytes
+		char * cursor;                  // The next free byte of the current chunk
+		char * limit;                   // The end of the current chunk
+		std::size_t chunkSize;          // The size of every chunk the arena allocates
+		std::size_t used;               // The amount of bytes handed out
+		bool releasing;                 // Is a flag if Deallocate is ignored until Release
+		
+		// Copy Constructor
+		// Arenas are not copyable, the blocks belong to one owner
+		EdgeArena(const EdgeArena & arena);
+		
+		// operator= Overload
+		// Arenas are not copyable, the blocks belong to one owner
+		EdgeArena & operator=(const EdgeArena & arena);
+		
+		// GetClass
+		// params:
+		//	bytes: This is the size of the block wanted
+		// Returns the smallest block size class that holds the bytes
+		static int GetClass(std::size_t bytes);
+		
+		// Reset
+		// Empties the free lists and starts carving from the callers region
+		void Reset();
+		
+	public:
+		// DefaultChunkSize
+		// This is the size of the chunks the arena allocates for itself
+		static const std::size_t DefaultChunkSize = 1 << 20;
+		
+		// Parameterized Constructor
+		// params:
+		//	chunkSize: This is the size of every chunk the arena allocates
+		// Creates an arena that allocates its own chunks
+		EdgeArena(std::size_t chunkSize = DefaultChunkSize);
+		
+		// Destructor
+		// Releases every chunk the arena allocated
+		~EdgeArena();
+		
+		// UseRegion
+		// params:
+		//	region: This is the start of the memory to use, NULL for none
+		//	size: This is the size of the memory in bytes
+		// Hands out blocks from the callers memory before allocating any
+		// chunks. The memory has to outlive the arena. Returns false if the
+		// arena has blocks out.
+		bool UseRegion(void * region, std::size_t size);
+		
+		// Allocate
+		// params:
+		//	bytes: This is the size of the block wanted
+		// Returns a block of at least the bytes, aligned to 16 bytes. Throws
+		// bad_alloc like operator new if the block is too big to hand out.
+		void * Allocate(std::size_t bytes);
+		
+		// Deallocate
+		// params:
+		//	block: This is a block made by Allocate
+		//	bytes: This is the size the block was allocated with
+		// Puts the block on the free list for its size
+		void Deallocate(void * block, std::size_t bytes);
+		
+		// BeginRelease
+		// Ignores every Deallocate until Release, so the containers holding
+		// the blocks can be destroyed without handing them back one by one
+		void BeginRelease();
+		
+		// Release
+		// Drops every block at once. The chunks the arena allocated are freed
+		// and the callers region is used again from its start.
+		void Release();
+		
+		// GetUsedBytes
+		// Returns the amount of bytes in the blocks handed out
+		std::size_t GetUsedBytes() const;
+}; // End EdgeArena Class
+
+// ArenaAllocator
+// This is a standard allocator that takes its memory from an EdgeArena,
+// or from the heap when it has no arena. Copies of a container get the
+// heap, so they are never tied to the arena of the one they came from.
+template <class T>
+class ArenaAllocator {
+	public:
+		typedef T value_type;
+		
+		EdgeArena * arena; // The arena the memory comes from, NULL for the heap
+		
+		// Parameterized Constructor
+		// params:
+		//	arena: This is the arena to allocate from, NULL for the heap
+		ArenaAllocator(EdgeArena * arena = NULL) : arena(arena) {
+			return;
+		}
+		
+		// Copy Constructor
+		// params:
+		//	allocator: This is the allocator for another type to share the arena of
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U> & allocator) : arena(allocator.arena) {
+			return;
+		}
+		
+		// allocate
+		// params:
+		//	count: This is the amount of items to make room for
+		// Returns uninitialized memory for the items
+		T * allocate(std::size_t count) {
+			return static_cast<T *>(arena != NULL ? arena->Allocate(count * sizeof(T)) : ::operator new(count * sizeof(T)));
+		}
+		
+		// deallocate
+		// params:
+		//	items: This is memory made by allocate
+		//	count: This is the amount of items it was made for
+		// Hands the memory back to where it came from
+		void deallocate(T * items, std::size_t count) {
+			if (arena != NULL) {
+				arena->Deallocate(items, count * sizeof(T));
+			} else {
+				::operator delete(items);
+			}
+			
+			return;
+		}
+		
+		// select_on_container_copy_construction
+		// Returns the allocator a copied container uses, which is the heap
+		ArenaAllocator select_on_container_copy_construction() const {
+			return ArenaAllocator();
+		}
+		
+		// operator== Overload
+		// params:
+		//	allocator: This is the allocator we are comparing against
+		// Returns true if memory from one can be freed by the other
+		template <class U>
+		bool operator==(const ArenaAllocator<U> & allocator) const {
+			return (arena == allocator.arena);
+		}
+		
+		// operator!= Overload
+		// params:
+		//	allocator: This is the allocator we are comparing against
+		// Returns true if memory from one can not be freed by the other
+		template <class U>
+		bool operator!=(const ArenaAllocator<U> & allocator) const {
+			return (arena != allocator.arena);
+		}
+}; // End ArenaAllocator Class
+
+#endif
@@ -0,0 +1,396 @@
+#include <cmath> // For pow
+#include <limits> // For the numeric_limits class
+#include <cstring> // For strncmp and memchr
+#include <cctype> // For tolower
+#include <vector> // For the vector class
+#include <algorithm> // For the copy function
+#include "Parallel.h"
+#include "MappedFile.h"
+#include "EdgeListReader.h"
+
+// Parameterized Constructor
+// params:
+//	threads: This is the amount of threads to parse with, 0 uses every core
+EdgeListReader::EdgeListReader(int threads) : threads(threads), skipped(0) {
+	if (this->threads < 1) {
+		this->threads = GetNumThreads();
+	}
+	
+	return;
+}
+
+// GetSkippedLines
+// Returns the amount of malformed lines skipped by the last read
+EdgeIndex EdgeListReader::GetSkippedLines() const {
+	return skipped;
+}
+
+// SkipSpaces
+// params:
+//	pos: This is the current position, moved past any spaces or tabs
+//	end: This is the end of the text
+// Skips spaces, tabs and carriage returns on the current line
+void EdgeListReader::SkipSpaces(const char * & pos, const char * end) {
+	while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) {
+		++pos;
+	}
+	
+	return;
+}
+
+// SkipLine
+// params:
+//	pos: This is the current position, moved to the start of the next line
+//	end: This is the end of the text
+// Skips the rest of the current line
+void EdgeListReader::SkipLine(const char * & pos, const char * end) {
+	const char * newline = (const char *)memchr(pos, '\n', end - pos);
+	
+	pos = (newline != NULL ? newline + 1 : end);
+	
+	return;
+}
+
+// ParseInteger
+// params:
+//	pos: This is the current position, moved past the number
+//	end: This is the end of the text
+//	value: This is set to the parsed number
+// Parses a whole number, returns false if there is none
+bool EdgeListReader::ParseInteger(const char * & pos, const char * end, long long & value) {
+	bool negative = false;
+	const char * start;
+	
+	SkipSpaces(pos, end);
+	
+	// Read the sign
+	if (pos < end && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		++pos;
+	}
+	
+	// Read every digit
+	start = pos;
+	value = 0;
+	while (pos < end && *pos >= '0' && *pos <= '9') {
+		value = value * 10 + (*pos - '0');
+		++pos;
+	}
+	
+	if (negative) {
+		value = -value;
+	}
+	
+	return (pos != start);
+}
+
+// ParseFloat
+// params:
+//	pos: This is the current position, moved past the number
+//	end: This is the end of the text
+//	value: This is set to the parsed number
+// Parses a decimal number with an optional exponent, returns false
+// if there is none
+bool EdgeListReader::ParseFloat(const char * & pos, const char * end, double & value) {
+	bool negative = false, digits = false;
+	double mantissa = 0;
+	long long exponent = 0, written = 0;
+	
+	SkipSpaces(pos, end);
+	
+	// Read the sign
+	if (pos < end && (*pos == '-' || *pos == '+')) {
+		negative = (*pos == '-');
+		++pos;
+	}
+	
+	// Read the whole part
+	while (pos < end && *pos >= '0' && *pos <= '9') {
+		mantissa = mantissa * 10 + (*pos - '0');
+		digits = true;
+		++pos;
+	}
+	
+	// Read the fraction
+	if (pos < end && *pos == '.') {
+		++pos;
+		
+		while (pos < end && *pos >= '0' && *pos <= '9') {
+			mantissa = mantissa * 10 + (*pos - '0');
+			exponent--;
+			digits = true;
+			++pos;
+		}
+	}
+	
+	// Read the exponent
+	if (digits && pos < end && (*pos == 'e' || *pos == 'E')) {
+		++pos;
+		
+		if (ParseInteger(pos, end, written)) {
+			exponent += written;
+		}
+	}
+	
+	value = (exponent == 0 ? mantissa : mantissa * pow(10.0, (double)exponent));
+	
+	if (negative) {
+		value = -value;
+	}
+	
+	return digits;
+}
+
+// ParseChunk
+// params:
+//	first: This is the start of the chunk
+//	last: This is the end of the chunk
+//	format: This is the format of the lines
+//	base: This is the ID of the first node in the file, 0 or 1
+//	weighted: Is a flag if a weight follows the two node IDs
+//	mirror: Is a flag if every edge should also be added reversed
+//	negate: Is a flag if the reversed edges get the negated weight
+//	edges: This is where the parsed edges are written, with room for
+//	       every line of the chunk, twice over when mirroring
+//	count: This is set to the amount of edges written
+//	maxID: This is set to the largest node ID seen
+// Parses every line in the chunk, returns how many were malformed
+EdgeIndex EdgeListReader::ParseChunk(const char * first, const char * last, EdgeListFormat format, int base, bool weighted, bool mirror, bool negate, Edge * edges, EdgeIndex & count, NodeID & maxID) {
+	const long long maxNode = std::numeric_limits<NodeID>::max();
+	const char * pos = first;
+	EdgeIndex malformed = 0;
+	
+	count = 0;
+	
+	// For every line in the chunk
+	while (pos < last) {
+		bool isEdge = true;
+		
+		SkipSpaces(pos, last);
+		
+		// Skip blank lines
+		if (pos >= last || *pos == '\n') {
+			SkipLine(pos, last);
+			continue;
+		}
+		
+		// Work out if this line holds an edge
+		if (format == DimacsFormat) {
+			isEdge = (*pos == 'a');
+			++pos;
+		} else if (*pos == '#' || *pos == '%') {
+			isEdge = false;
+		}
+		
+		if (isEdge) {
+			long long start, end;
+			double weight = 0;
+			bool valid = ParseInteger(pos, last, start) && ParseInteger(pos, last, end);
+			
+			// If there should be a weight read it, SNAP lists may leave it out
+			if (valid && weighted) {
+				SkipSpaces(pos, last);
+				
+				if (pos < last && *pos != '\n') {
+					valid = ParseFloat(pos, last, weight);
+				} else {
+					valid = (format == SnapFormat);
+				}
+			}
+			
+			start -= base;
+			end -= base;
+			
+			// If the IDs fit in a NodeID add the edge
+			if (valid && start >= 0 && end >= 0 && start < maxNode && end < maxNode) {
+				edges[count++] = Edge(start, end, (Weight)weight);
+				
+				if (mirror && start != end) {
+					edges[count++] = Edge(end, start, (Weight)(negate ? -weight : weight));
+				}
+				
+				if (start > maxID) {
+					maxID = start;
+				}
+				
+				if (end > maxID) {
+					maxID = end;
+				}
+			} else {
+				malformed++;
+			}
+		}
+		
+		SkipLine(pos, last);
+	}
+	
+	return malformed;
+}
+
+// Read
+// params:
+//	path: This is the path of the file to read
+//	format: This is the format the file is in
+//	builder: This is the builder the edges are added to
+// Parses every edge in the file into the builder. Returns false if
+// the file could not be read or its header is not understood.
+bool EdgeListReader::Read(const std::string & path, EdgeListFormat format, GraphBuilder & builder) {
+	MappedFile file;
+	bool valid = false, weighted = true, mirror = false, negate = false;
+	int base = 0;
+	
+	skipped = 0;
+	
+	// If the file could not be mapped there is nothing to read
+	if (!file.Open(path)) {
+		return false;
+	}
+	
+	const char * body = file.GetData(), * end = file.GetData() + file.GetSize();
+	valid = true;
+	
+	// If this is a DIMACS file
+	if (format == DimacsFormat) {
+		base = 1;
+		
+		// Read the comment and problem lines at the top of the file
+		while (body < end && (*body == 'c' || *body == 'p' || *body == '\n' || *body == '\r')) {
+			// If this is the problem line take the node count from it
+			if (*body == 'p') {
+				const char * pos = body + 1;
+				long long nodes;
+				
+				SkipSpaces(pos, end);
+				
+				// Skip the problem type
+				while (pos < end && *pos != ' ' && *pos != '\t' && *pos != '\n') {
+					++pos;
+				}
+				
+				if (ParseInteger(pos, end, nodes) && nodes > 0 && nodes < (long long)std::numeric_limits<NodeID>::max()) {
+					builder.SetNumVertices(nodes);
+				}
+			}
+			
+			SkipLine(body, end);
+		}
+	
+	// If this is a MatrixMarket file
+	} else if (format == MatrixMarketFormat) {
+		const char * banner = body;
+		long long rows, cols, entries;
+		std::string line;
+		
+		base = 1;
+		
+		// Read the banner line
+		SkipLine(body, end);
+		line.assign(banner, body);
+		
+		for (int i = 0; i < line.size(); i++) {
+			line[i] = tolower(line[i]);
+		}
+		
+		// Only sparse coordinate matrices can be read as edge lists
+		valid = (strncmp(banner, "%%MatrixMarket", 14) == 0 &&
+				 line.find("coordinate") != std::string::npos &&
+				 line.find("complex") == std::string::npos);
+		weighted = (line.find("pattern") == std::string::npos);
+		mirror = (line.find("symmetric") != std::string::npos || line.find("hermitian") != std::string::npos);
+		negate = (line.find("skew-symmetric") != std::string::npos);
+		
+		// An undirected edge has one weight, so it can not hold both entries
+		// of a skew-symmetric matrix
+		if (negate && !builder.directed) {
+			valid = false;
+		}
+		
+		// Skip the comments before the size line
+		while (body < end && (*body == '%' || *body == '\n' || *body == '\r')) {
+			SkipLine(body, end);
+		}
+		
+		// Read the size line
+		if (valid && ParseInteger(body, end, rows) && ParseInteger(body, end, cols) && ParseInteger(body, end, entries)) {
+			builder.SetNumVertices(rows > cols ? rows : cols);
+			SkipLine(body, end);
+		} else {
+			valid = false;
+		}
+	}
+	
+	// Undirected builders add the reverse of every edge themselves
+	mirror = (mirror && builder.directed);
+	
+	if (valid) {
+		std::vector<const char *> firsts(threads), lasts(threads);
+		std::vector<EdgeIndex> room(threads + 1, 0), counts(threads, 0), malformed(threads, 0);
+		std::vector<NodeID> maxIDs(threads, -1);
+		EdgeIndex next = builder.edges.size();
+		NodeID maxID = -1;
+		
+		// Split the body into a chunk per thread, a chunk owns every line
+		// that starts inside it
+		for (int i = 0; i < threads; i++) {
+			firsts[i] = body + (end - body) * i / threads;
+			lasts[i] = body + (end - body) * (i + 1) / threads;
+			
+			if (firsts[i] != body && firsts[i][-1] != '\n') {
+				SkipLine(firsts[i], end);
+			}
+			
+			if (lasts[i] != end && lasts[i][-1] != '\n') {
+				SkipLine(lasts[i], end);
+			}
+		}
+		
+		// Count the lines of every chunk, which bounds the edges it holds
+		ParallelThreads([&](int thread, int count) {
+			const char * pos = firsts[thread];
+			EdgeIndex lines = 0;
+			
+			while (pos < lasts[thread]) {
+				lines++;
+				SkipLine(pos, lasts[thread]);
+			}
+			
+			room[thread + 1] = (mirror ? 2 * lines : lines);
+		}, threads);
+		
+		// Make room for every chunk once, right where the builder keeps its
+		// edges, so nothing is parsed into a copy first
+		room[0] = builder.edges.size();
+		for (int i = 0; i < threads; i++) {
+			room[i + 1] += room[i];
+		}
+		
+		builder.edges.resize(room[threads], Edge(0, 0));
+		
+		// Parse every chunk into its room
+		ParallelThreads([&](int thread, int count) {
+			if (firsts[thread] < lasts[thread]) {
+				malformed[thread] = ParseChunk(firsts[thread], lasts[thread], format, base, weighted, mirror, negate, builder.edges.data() + room[thread], counts[thread], maxIDs[thread]);
+			}
+		}, threads);
+		
+		// Close the gaps left by comments, blank and malformed lines, the
+		// edges stay in file order
+		for (int i = 0; i < threads; i++) {
+			if (next != room[i]) {
+				std::copy(builder.edges.begin() + room[i], builder.edges.begin() + room[i] + counts[i], builder.edges.begin() + next);
+			}
+			
+			next += counts[i];
+			skipped += malformed[i];
+			
+			if (maxIDs[i] > maxID) {
+				maxID = maxIDs[i];
+			}
+		}
+		
+		builder.edges.resize(next, Edge(0, 0));
+		builder.SetNumVertices(maxID + 1);
+	}
+	
+	return valid;
+}
\ No newline at end of file
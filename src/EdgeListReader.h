@@ -0,0 +1,94 @@
+#ifndef EDGE_LIST_READER_H
+#define EDGE_LIST_READER_H
+
+#include <string> // For the string class
+#include "GraphBuilder.h" // For the GraphBuilder class
+
+// EdgeListFormat
+// These are the text formats the EdgeListReader understands
+enum EdgeListFormat {
+	SnapFormat,         // "u v [w]" per line, 0 based, '#' or '%' comments
+	DimacsFormat,       // DIMACS shortest path ".gr", "a u v w" arcs, 1 based
+	MatrixMarketFormat  // MatrixMarket coordinate files, 1 based
+};
+
+// EdgeListReader
+// This class loads text edge lists straight into a GraphBuilder. The file
+// is mapped into memory, split into one chunk per thread on line breaks,
+// and every chunk is parsed in parallel without iostreams. Edges without
+// a weight get a weight of 0, the same default as Graph::AddEdge.
+class EdgeListReader {
+	private:
+		int threads;          // This is the amount of threads to parse with
+		EdgeIndex skipped;    // This is the amount of malformed lines skipped by the last read
+		
+		// SkipSpaces
+		// params:
+		//	pos: This is the current position, moved past any spaces or tabs
+		//	end: This is the end of the text
+		// Skips spaces, tabs and carriage returns on the current line
+		static void SkipSpaces(const char * & pos, const char * end);
+		
+		// SkipLine
+		// params:
+		//	pos: This is the current position, moved to the start of the next line
+		//	end: This is the end of the text
+		// Skips the rest of the current line
+		static void SkipLine(const char * & pos, const char * end);
+		
+		// ParseInteger
+		// params:
+		//	pos: This is the current position, moved past the number
+		//	end: This is the end of the text
+		//	value: This is set to the parsed number
+		// Parses a whole number, returns false if there is none
+		static bool ParseInteger(const char * & pos, const char * end, long long & value);
+		
+		// ParseFloat
+		// params:
+		//	pos: This is the current position, moved past the number
+		//	end: This is the end of the text
+		//	value: This is set to the parsed number
+		// Parses a decimal number with an optional exponent, returns false
+		// if there is none
+		static bool ParseFloat(const char * & pos, const char * end, double & value);
+		
+		// ParseChunk
+		// params:
+		//	first: This is the start of the chunk
+		//	last: This is the end of the chunk
+		//	format: This is the format of the lines
+		//	base: This is the ID of the first node in the file, 0 or 1
+		//	weighted: Is a flag if a weight follows the two node IDs
+		//	mirror: Is a flag if every edge should also be added reversed
+		//	negate: Is a flag if the reversed edges get the negated weight
+		//	edges: This is where the parsed edges are written, with room for
+		//	       every line of the chunk, twice over when mirroring
+		//	count: This is set to the amount of edges written
+		//	maxID: This is set to the largest node ID seen
+		// Parses every line in the chunk, returns how many were malformed
+		static EdgeIndex ParseChunk(const char * first, const char * last, EdgeListFormat format, int base, bool weighted, bool mirror, bool negate, Edge * edges, EdgeIndex & count, NodeID & maxID);
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	threads: This is the amount of threads to parse with, 0 uses every core
+		EdgeListReader(int threads = 0);
+		
+		// Read
+		// params:
+		//	path: This is the path of the file to read
+		//	format: This is the format the file is in
+		//	builder: This is the builder the edges are added to
+		// Parses every edge in the file into the builder. Skew-symmetric
+		// MatrixMarket files give every reversed entry the negated weight, so
+		// they need a directed builder. Returns false if the file could not
+		// be read or its header is not understood.
+		bool Read(const std::string & path, EdgeListFormat format, GraphBuilder & builder);
+		
+		// GetSkippedLines
+		// Returns the amount of malformed lines skipped by the last read
+		EdgeIndex GetSkippedLines() const;
+}; // End EdgeListReader Class
+
+#endif
\ No newline at end of file
@@ -1,64 +1,202 @@
 #include <iostream>
-#include <cmath>
-#include "UnionFind.h"
-#include "Heap.h"
+#include <algorithm> // For the sort function
 #include "Graph.h"
 
 //Default constructor
-Graph::Graph() {
+Graph::Graph() : arena(new EdgeArena()) {
 	Clear();
 	return;
 }
 
+// Copy Constructor
+// params:
+//	graph: This is the graph being copied
+// Copies the graph into an arena of its own, without the region
+Graph::Graph(const Graph & graph) : arena(new EdgeArena()) {
+	Clear();
+	*this = graph;
+	return;
+}
+
+// Destructor
+// Releases the edges of every node at once
+Graph::~Graph() {
+	Clear();
+	return;
+}
+
+// operator= Overload
+// params:
+//	graph: This is the graph being copied
+// Replaces this graph with a copy of the graph, keeping our region
+Graph & Graph::operator=(const Graph & graph) {
+	// If this is not the same graph
+	if (this != &graph) {
+		Clear();
+		
+		// Copy every node, tombstones included, into our arena
+		adjList.reserve(graph.adjList.size());
+		for (NodeID i = 0; i < graph.adjList.size(); i++) {
+			CopyNode(adjList, graph.adjList[i], NULL);
+		}
+		
+		mst.reserve(graph.mst.size());
+		for (NodeID i = 0; i < graph.mst.size(); i++) {
+			CopyNode(mst, graph.mst[i], NULL);
+		}
+		
+		vertices = graph.vertices;
+		edges = graph.edges;
+		removed = graph.removed;
+		asymmetric = graph.asymmetric;
+		oneWayIn = graph.oneWayIn;
+		maintainMST = graph.maintainMST;
+	}
+	
+	return *this;
+}
+
+// UseRegion
+// params:
+//	region: This is the start of the memory to use, NULL for none
+//	size: This is the size of the memory in bytes
+// Places the edges of every node in memory the caller owns until it
+// runs out. Returns false if the graph has nodes.
+bool Graph::UseRegion(void * region, std::size_t size) {
+	return (adjList.empty() && mst.empty() && arena->UseRegion(region, size));
+}
+
 // GetNumVertices
 // Returns the number of vertices in the graph
-int Graph::GetNumVertices() const {
+NodeID Graph::GetNumVertices() const {
 	return vertices;
 }
 
 // GetNumEdges
 // Returns the number of edges in the graph
-int Graph::GetNumEdges() const {
+EdgeIndex Graph::GetNumEdges() const {
 	return edges;
 }
 
 // AddNode
 // Add the node to the adjacency list, returns the new nodes ID
-int Graph::AddNode() {
-	// Add the entry to the adjacency list
-	// and increment the number of vertices
-	adjList.push_back(Node(vertices++));
+NodeID Graph::AddNode() {
+	NodeID id = adjList.size();
+	
+	DropPathQuery();
 	
-	return (vertices - 1);
+	// Add the entry to the adjacency list, after any removed
+	// IDs, and increment the number of vertices
+	adjList.push_back(Node(id, arena.get()));
+	removed.push_back(false);
+	oneWayIn.push_back(std::vector<NodeID>());
+	vertices++;
+	
+	// The new node starts as a tree of its own
+	if (maintainMST) {
+		mst.push_back(Node(id, arena.get()));
+	}
+	
+	return id;
 }
 
-/*// RemoveNode
+// RemoveNode
 // params:
 //	node: This is the node we wish to remove from the graph
-// Removes the node from the adjancy list, if it exists
+// Removes the node and every edge touching it, returns false if the
+// node does not exist. The ID is left as a tombstone until Compact.
 bool Graph::RemoveNode(NodeID node) {
-	bool removed = false;
+	bool removedNode = false;
 	
 	// If the graph contains the node
 	if (Contains(node)) {
-		// Erase this node from the adjacency list
-		adjList.erase(adjList.begin() + GetIndex(node));
+		DropPathQuery();
 		
-		// For every node in our adjacency list
-		for (int i = 0; i < adjList.size(); i++) {
-			// Remove any edge to the node we are removing
-			adjList[i].RemoveEdge(node);
+		// Remove every edge of the node along with its reverse, last
+		// first so nothing has to shift
+		while (adjList[node].GetDegree() != 0) {
+			RemoveEdge(node, adjList[node].GetTarget(adjList[node].GetDegree() - 1));
 		}
 		
+		// Remove the edges pointing at the node without a reverse, each
+		// removal drops it from the record
+		while (!oneWayIn[node].empty()) {
+			RemoveEdge(oneWayIn[node].back(), node);
+		}
+		
+		// Leave a tombstone so every other ID stays the same
+		adjList[node] = Node(node, arena.get());
+		removed[node] = true;
+		
 		// Decrement the number of vertices
 		vertices--;
 		
 		// We removed the node
-		removed = true;
+		removedNode = true;
 	}
 	
-	return removed;
-}*/
+	return removedNode;
+}
+
+// Compact
+// Renumbers the nodes left so the IDs are dense again and releases
+// the memory held by removed nodes. Returns the new ID of every old
+// ID, -1 for the removed ones.
+std::vector<NodeID> Graph::Compact() {
+	std::vector<NodeID> newIDs(adjList.size(), -1);
+	AdjList packed, packedMST;
+	NodeID next = 0;
+	
+	DropPathQuery();
+	
+	// Hand out the new IDs in order
+	for (NodeID i = 0; i < adjList.size(); i++) {
+		if (!removed[i]) {
+			newIDs[i] = next++;
+		}
+	}
+	
+	// Rebuild every node left under its new ID, along with its part of the MSF
+	packed.reserve(next);
+	for (NodeID i = 0; i < adjList.size(); i++) {
+		if (removed[i]) {
+			continue;
+		}
+		
+		CopyNode(packed, adjList[i], &newIDs);
+		
+		if (maintainMST) {
+			CopyNode(packedMST, mst[i], &newIDs);
+		}
+	}
+	
+	// Move the record of one way edges over to the new IDs, no node left
+	// has one from a removed node
+	std::vector<std::vector<NodeID> > packedIn(next);
+	for (NodeID i = 0; i < oneWayIn.size(); i++) {
+		if (removed[i]) {
+			continue;
+		}
+		
+		packedIn[newIDs[i]].swap(oneWayIn[i]);
+		for (NodeID j = 0; j < packedIn[newIDs[i]].size(); j++) {
+			packedIn[newIDs[i]][j] = newIDs[packedIn[newIDs[i]][j]];
+		}
+	}
+	
+	adjList.swap(packed);
+	mst.swap(packedMST);
+	oneWayIn.swap(packedIn);
+	removed.assign(adjList.size(), false);
+	
+	return newIDs;
+}
+
+// GetNumRemoved
+// Returns the number of removed node IDs that Compact would reclaim
+NodeID Graph::GetNumRemoved() const {
+	return adjList.size() - vertices;
+}
 
 // AddEdge
 // params:
@@ -68,24 +206,48 @@ bool Graph::RemoveNode(NodeID node) {
 //	directed: This is a flag if the link is bidirectional or not
 // Adds the edge between the start and end node, if directional is false
 // then an edge will be added between end and start as well.
-bool Graph::AddEdge(NodeID startID, NodeID endID, float weight, bool directed) {
+bool Graph::AddEdge(NodeID startID, NodeID endID, Weight weight, bool directed) {
 	bool added = false;
 	
 	// If the graph contains the starting and ending node
 	if (ContainsPair(startID, endID)) {
-		// Add the edge from the starting node to the ending node
-		adjList[GetIndex(startID)].AddEdge(endID, weight);
+		Weight before = 0, after;
+		bool existed = false, addedForward = false;
+		
+		DropPathQuery();
 		
-		// Increment the number of edges
-		edges++;
+		// Remember the pair as it was so the MSF can be repaired
+		if (maintainMST) {
+			existed = GetPairWeight(startID, endID, before);
+		}
+		
+		asymmetric -= CountAsymmetric(startID, endID);
+		
+		// Add the edge from the starting node to the ending node
+		if (adjList[GetIndex(startID)].AddEdge(endID, weight)) {
+			// Increment the number of edges
+			edges++;
+			addedForward = true;
+		}
 		
 		// If this link is not directed
 		if (!directed) {
 			// Add the edge from the ending node to the starting node
-			adjList[GetIndex(endID)].AddEdge(startID, weight);
-			
-			// Increment the number of edges
-			edges++;	
+			if (adjList[GetIndex(endID)].AddEdge(startID, weight))
+				// Increment the number of edges
+				edges++;
+		}
+		
+		asymmetric += CountAsymmetric(startID, endID);
+		
+		// Record a new edge without a reverse so RemoveNode can find it
+		if (addedForward && !adjList[GetIndex(endID)].ContainsEdge(startID)) {
+			oneWayIn[endID].push_back(startID);
+		}
+		
+		// If the pair is new or got lighter the MSF may have to change
+		if (maintainMST && GetPairWeight(startID, endID, after) && (!existed || after < before)) {
+			InsertMSTEdge(startID, endID);
 		}
 		
 		// We added the edge
@@ -106,15 +268,29 @@ bool Graph::RemoveEdge(NodeID startID, NodeID endID) {
 	
 	// If the graph contains both the starting and ending node
 	if (ContainsPair(startID, endID)) {
-		// Remove the edge between the starting and ending node
-		if (adjList[GetIndex(startID)].RemoveEdge(endID))
+		DropPathQuery();
+		
+		asymmetric -= CountAsymmetric(startID, endID);
+		
+		// Remove the edge between the starting and ending node, and forget
+		// it if it was recorded as one way
+		if (adjList[GetIndex(startID)].RemoveEdge(endID)) {
 			// Decrement the number of edges
 			edges--;
+			DropOneWayIn(endID, startID);
+		}
 		
 		// Remove the edge between the ending and starting node
-		if (adjList[GetIndex(endID)].RemoveEdge(startID))
+		if (adjList[GetIndex(endID)].RemoveEdge(startID)) {
 			// Decrement the number of edges
 			edges--;
+			DropOneWayIn(startID, endID);
+		}
+		
+		// If the pair was in the MSF it needs a replacement
+		if (maintainMST) {
+			DeleteMSTEdge(startID, endID);
+		}
 		
 		// We removed the edges
 		removed = true;
@@ -128,11 +304,22 @@ bool Graph::RemoveEdge(NodeID startID, NodeID endID) {
 //	node: This is the node for whose neighbors we want
 // Returns an EdgeList with all neighbors for that node
 EdgeList Graph::GetNodeEdges(NodeID node) const {
-	if (node >= 0 && node < adjList.size())
-		return adjList[node].GetEdges();
+	if (Contains(node))
+		return adjList[GetIndex(node)].GetEdges();
 	return EdgeList();
 }
 
+// GetNodeNeighbors
+// params:
+//	node: This is the node for whose neighbors we want
+// Returns a view over the neighbors of that node without copying
+// them, the view is empty if the node does not exist
+NeighborRange Graph::GetNodeNeighbors(NodeID node) const {
+	if (Contains(node))
+		return adjList[GetIndex(node)].GetNeighbors();
+	return NeighborRange();
+}
+
 // Contains
 // params:
 //	node: This is the node we are looking for
@@ -147,244 +334,603 @@ bool Graph::Contains(NodeID node) const {
 //	nodeTwo: This is the second node we are looking for
 // Returns true if the graph contains both nodes, false otherwise
 bool Graph::ContainsPair(NodeID nodeOne, NodeID nodeTwo) const {
-	bool containsFirst = false, containsSecond = false;
+	return (Contains(nodeOne) && Contains(nodeTwo));
+}
+
+// GetIndex
+// params:
+//	node: This is the node we wish to find
+// Finds the given node and returns its index
+NodeID Graph::GetIndex(NodeID node) const {
+	NodeID index = -1;
+	
+	// IDs are handed out densely by AddNode and removed nodes leave
+	// tombstones, so a nodes ID is also its index in the adjacency list
+	if (node >= 0 && node < adjList.size() && !removed[node]) {
+		index = node;
+	}
+	
+	return index;
+}
+
+// Clear
+// Resets all values used to by the graph to a default value
+void Graph::Clear() {
+	DropPathQuery();
+	
+	// Destroy the nodes without handing their edges back to the arena
+	// one by one, then drop every block at once
+	arena->BeginRelease();
+	adjList.clear();
+	mst.clear();
+	arena->Release();
+	
+	vertices = 0;
+	edges = 0;
+	removed.clear();
+	asymmetric = 0;
+	oneWayIn.clear();
+	maintainMST = false;
+	mstTree.clear();
 	
-	// For every node while we haven't found both nodes
-	for (int i = 0; (i < adjList.size()) && (!containsFirst || !containsSecond); i++) {
-		// If this is a node we are looking for
-		if (adjList[i].GetID() == nodeOne) {
-			containsFirst = true;
+	return;
+}
+
+// Freeze
+// Packs the current state of the graph into an immutable CsrGraph
+// snapshot that the graph algorithms can run on directly, with every
+// nodes neighbors sorted by ID
+CsrGraph Graph::Freeze() const {
+	CsrGraph csr;
+	std::vector<std::pair<NodeID, Weight> > sorted;
+	
+	// Size the arrays once for every vertex and edge
+	csr.offsetStorage.resize(adjList.size() + 1);
+	csr.targetStorage.reserve(edges);
+	csr.weightStorage.reserve(WeightedEdges ? edges : 0);
+	
+	// For every node in the adjacency list
+	for (NodeID i = 0; i < adjList.size(); i++) {
+		const Node & node = adjList[i];
+		
+		// Record where this nodes neighbors begin
+		csr.offsetStorage[i] = csr.targetStorage.size();
+		
+		// Sort the neighbors by ID so the snapshot can binary search them,
+		// a node never holds the same neighbor twice
+		sorted.clear();
+		for (int j = 0; j < node.GetDegree(); j++) {
+			sorted.push_back(std::make_pair(node.GetTarget(j), node.GetWeight(j)));
 		}
 		
-		// If this is a node we are looking for
-		if (adjList[i].GetID() == nodeTwo) {
-			containsSecond = true;
+		std::sort(sorted.begin(), sorted.end());
+		
+		// Pack every neighbor and weight contiguously
+		for (int j = 0; j < sorted.size(); j++) {
+			csr.targetStorage.push_back(sorted[j].first);
+			
+			if (WeightedEdges) {
+				csr.weightStorage.push_back(sorted[j].second);
+			}
 		}
 	}
 	
-	return (containsFirst && containsSecond);
+	// Close off the last nodes neighbors
+	csr.offsetStorage[adjList.size()] = csr.targetStorage.size();
+	csr.BindStorage();
+	
+	return csr;
 }
 
-// GetIndex
+// PrimsAlgorithm
 // params:
-//	node: This is the node we wish to find
-// Finds the given node and returns its index
-int Graph::GetIndex(NodeID node) const {
-	int index = -1;
-	
-	// For every node while we haven't found the node
-	for (int i = 0; (i < adjList.size()) && (index == -1); i++) {
-		// If this is the node we are looking for
-		if (adjList[i].GetID() == node) {
-			// Get its index
-			index = i;
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the graph and returns the produced MSF
+AdjList Graph::PrimsAlgorithm(NodeID start) const {
+	return Freeze().PrimsAlgorithm(start);
+}
+
+// PrimsAlgorithm
+// params:
+//	forest: This is filled with the edges of the produced MSF
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the current state of the graph without
+// building an adjacency list
+void Graph::PrimsAlgorithm(SpanningForest & forest, NodeID start) const {
+	Freeze().PrimsAlgorithm(forest, start);
+	return;
+}
+
+// PrimsAlgorithm
+// params:
+//	parents: This is filled with the parent of every node in the MSF
+//	start: This is the starting node for the produced MSF
+// Runs Prim's Algorithm on the current state of the graph and returns
+// the weight of the MSF
+Weight Graph::PrimsAlgorithm(std::vector<NodeID> & parents, NodeID start) const {
+	return Freeze().PrimsAlgorithm(parents, start);
+}
+
+// KruskalsAlgorithm
+// Performs Kruskals Algorithm on the current state of the
+// graph and returns an EdgeList that makes a MSF
+AdjList Graph::KruskalsAlgorithm() const {
+	return Freeze().KruskalsAlgorithm();
+}
+
+// KruskalsAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+// Performs Kruskals Algorithm on the current state of the graph
+// without building an adjacency list
+void Graph::KruskalsAlgorithm(SpanningForest & forest) const {
+	Freeze().KruskalsAlgorithm(forest);
+	return;
+}
+
+// FilterKruskalAlgorithm
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs the Filter-Kruskal Algorithm on the current state of the
+// graph and returns the same MSF as KruskalsAlgorithm
+AdjList Graph::FilterKruskalAlgorithm(int threads) const {
+	return Freeze().FilterKruskalAlgorithm(threads);
+}
+
+// FilterKruskalAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs the Filter-Kruskal Algorithm on the current state of the
+// graph without building an adjacency list
+void Graph::FilterKruskalAlgorithm(SpanningForest & forest, int threads) const {
+	Freeze().FilterKruskalAlgorithm(forest, threads);
+	return;
+}
+
+// BoruvkaAlgorithm
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs Boruvkas Algorithm on the current state of the graph
+// using every core and returns the same MSF as KruskalsAlgorithm
+AdjList Graph::BoruvkaAlgorithm(int threads) const {
+	return Freeze().BoruvkaAlgorithm(threads);
+}
+
+// BoruvkaAlgorithm
+// params:
+//	forest: This is filled with the edges of the MSF in KruskalOrder
+//	threads: This is the amount of threads to use, 0 uses every core
+// Performs Boruvkas Algorithm on the current state of the graph
+// without building an adjacency list
+void Graph::BoruvkaAlgorithm(SpanningForest & forest, int threads) const {
+	Freeze().BoruvkaAlgorithm(forest, threads);
+	return;
+}
+
+// Dijkstra
+// params:
+//	source: This is the node the search starts from
+//	queue: This is the priority queue to run on
+// Runs Dijkstras Algorithm on the current state of the graph and returns
+// the distance to and parent of every node
+ShortestPathTree Graph::Dijkstra(NodeID source, ShortestPathQueue queue) const {
+	return Freeze().Dijkstra(source, queue);
+}
+
+// Dijkstra
+// params:
+//	source: This is the node the search starts from
+//	target: This is the node the search stops at
+//	queue: This is the priority queue to run on
+// Runs Dijkstras Algorithm on the current state of the graph and stops as
+// soon as the target is settled, only its distance and path are final
+ShortestPathTree Graph::Dijkstra(NodeID source, NodeID target, ShortestPathQueue queue) const {
+	return Freeze().Dijkstra(source, target, queue);
+}
+
+// DeltaStepping
+// params:
+//	source: This is the node the search starts from
+//	delta: This is the width of each bucket, 0 picks one from the weights
+//	threads: This is the amount of threads to use, 0 uses every core
+// Runs the parallel delta-stepping shortest path algorithm on the current
+// state of the graph and returns the same distances as Dijkstra
+ShortestPathTree Graph::DeltaStepping(NodeID source, Weight delta, int threads) const {
+	return Freeze().DeltaStepping(source, delta, threads);
+}
+
+// BreadthFirstSearch
+// params:
+//	source: This is the node the search starts from
+//	threads: This is the amount of threads to use, 0 uses every core
+// Runs a direction optimizing breadth first search on the current state
+// of the graph and returns the level and parent of every node
+BreadthFirstTree Graph::BreadthFirstSearch(NodeID source, int threads) const {
+	const CsrGraph & csr = GetSnapshot();
+	
+	return csr.BreadthFirstSearch(source, pathIncoming.get(), threads);
+}
+
+// ConnectedComponents
+// params:
+//	threads: This is the amount of threads to use, 0 uses every core
+// Labels every node of the current state of the graph with its weakly
+// connected component, directed edges join nodes as if they went both
+// ways. Returns the label of every node, which is the smallest node ID
+// in its component.
+std::vector<NodeID> Graph::ConnectedComponents(int threads) const {
+	const CsrGraph & csr = GetSnapshot();
+	
+	return csr.ConnectedComponents(pathIncoming.get(), threads);
+}
+
+// ShortestPath
+// params:
+//	source: This is the node the path starts at
+//	target: This is the node the path ends at
+//	path: This is filled with the nodes on the path if it is not NULL
+// Runs a bidirectional Dijkstra on the current state of the graph and
+// returns the length of the shortest path, infinite if there is none
+Weight Graph::ShortestPath(NodeID source, NodeID target, std::vector<NodeID> * path) const {
+	return GetPathQuery().ShortestPath(source, target, path);
+}
+
+// GetSnapshot
+// Returns the cached snapshot, freezing the graph and building the
+// Transpose when one is needed if the graph changed since the last query
+const CsrGraph & Graph::GetSnapshot() const {
+	if (pathGraph == NULL) {
+		pathGraph.reset(new CsrGraph(Freeze()));
+		
+		// Following edges backwards only needs the Transpose when an edge
+		// has no matching reverse
+		if (asymmetric > 0) {
+			pathIncoming.reset(new CsrGraph(pathGraph->Transpose()));
 		}
 	}
 	
-	return index;
+	return *pathGraph;
 }
 
+// GetPathQuery
+// Returns the cached path query, building it and its snapshot if the
+// graph changed since the last query
+PathQuery & Graph::GetPathQuery() const {
+	if (pathQuery == NULL) {
+		const CsrGraph & csr = GetSnapshot();
+		
+		pathQuery.reset(new PathQuery(csr, pathIncoming.get()));
+	}
+	
+	return *pathQuery;
+}
 
-// Quicksort
+// DropPathQuery
+// Releases the cached path query, called whenever the graph changes
+void Graph::DropPathQuery() {
+	pathQuery.reset();
+	pathIncoming.reset();
+	pathGraph.reset();
+	
+	return;
+}
+
+// GetPairWeight
 // params:
-//	edges: This is the list of edges to sort
-//	size: This is the size of the array in which is being sorted
-// Performs the Quicksort algorithm on the list of edges
-void Graph::QuickSort(EdgeList & edges, const int & low, const int & high) const {
-	// If the gap is greater than one
-	if (low < high) {
-		// Create a partition point
-		int partition = Partition(edges, low, high);
-		
-		// Sort the sub arrays
-		QuickSort(edges, low, (partition - 1));
-		QuickSort(edges, (partition + 1), high);
+//	nodeOne: This is the node at one end of the pair
+//	nodeTwo: This is the node at the other end of the pair
+//	weight: This is set to the weight of the lighter edge between them
+// Returns true if there is an edge between the nodes in either direction
+bool Graph::GetPairWeight(NodeID nodeOne, NodeID nodeTwo, Weight & weight) const {
+	int one = adjList[nodeOne].GetEdgeIndex(nodeTwo), two = adjList[nodeTwo].GetEdgeIndex(nodeOne);
+	
+	if (one != -1) {
+		weight = adjList[nodeOne].GetWeight(one);
+	}
+	
+	if (two != -1 && (one == -1 || adjList[nodeTwo].GetWeight(two) < weight)) {
+		weight = adjList[nodeTwo].GetWeight(two);
+	}
+	
+	return (one != -1 || two != -1);
+}
+
+// CountAsymmetric
+// params:
+//	nodeOne: This is the node at one end of the pair
+//	nodeTwo: This is the node at the other end of the pair
+// Returns how many of the edges between the nodes have no reverse
+// edge of the same weight
+int Graph::CountAsymmetric(NodeID nodeOne, NodeID nodeTwo) const {
+	int one = adjList[nodeOne].GetEdgeIndex(nodeTwo), two = adjList[nodeTwo].GetEdgeIndex(nodeOne);
+	
+	// If both directions are there they either match or both count
+	if (one != -1 && two != -1) {
+		return (adjList[nodeOne].GetWeight(one) == adjList[nodeTwo].GetWeight(two) ? 0 : 2);
+	}
+	
+	return (one != -1) + (two != -1);
+}
+
+// CopyNode
+// params:
+//	list: This is the list the copy is added to
+//	old: This is the node being copied
+//	newIDs: This is the new ID of every old ID, NULL keeps the IDs
+// Adds a copy of the node to the list with its edges in our arena
+void Graph::CopyNode(AdjList & list, const Node & old, const std::vector<NodeID> * newIDs) {
+	list.push_back(Node(newIDs != NULL ? (*newIDs)[old.GetID()] : old.GetID(), arena.get()));
+	Node & node = list.back();
+	
+	node.ReserveEdges(old.GetDegree());
+	for (int j = 0; j < old.GetDegree(); j++) {
+		node.AppendEdge(newIDs != NULL ? (*newIDs)[old.GetTarget(j)] : old.GetTarget(j), old.GetWeight(j));
+	}
+	
+	// High degree nodes get their neighbor index straight away
+	if (node.GetDegree() > Node::IndexThreshold) {
+		node.BuildIndex();
 	}
 	
 	return;
 }
 
-// Clear
-// Resets all values used to by the graph to a default value
-void Graph::Clear() {
-	adjList.clear();
-	vertices = 0;
-	edges = 0;
+// DropOneWayIn
+// params:
+//	node: This is the node the edge went into
+//	source: This is the node the edge came from
+// Forgets the one way edge from the source into the node, if recorded
+void Graph::DropOneWayIn(NodeID node, NodeID source) {
+	std::vector<NodeID> & sources = oneWayIn[node];
+	
+	// Search from the back, where RemoveNode takes them from, so draining
+	// a node costs a step per edge. The order does not matter, so the gap
+	// is filled with the last one.
+	for (NodeID i = (NodeID)sources.size() - 1; i >= 0; i--) {
+		if (sources[i] == source) {
+			sources[i] = sources.back();
+			sources.pop_back();
+			break;
+		}
+	}
 	
 	return;
 }
 
-// Partition
-// params:
-//	edges: This is the list of edges to sort
-//	low: This is the lower bound index in the array to partition
-//	high: This is the higher bound index in the array to partition
-// Takes the edges and returns a partition point used in the Quick sort algorithm
-int Graph::Partition(EdgeList & edges, const int & low, const int & high) const {
-	Edge temp(0, 0), pivot(edges[high]);
-	int i = low;
-	
-	// For every element in the sub array
-	for (int j = low; j < high; ++j) {
-		// If this element is less than our pivot
-		if (edges[j] < pivot) {
-			// Swap the elements
-			temp = edges[i];
-			edges[i] = edges[j];
-			edges[j] = temp;
+// RecountAsymmetric
+// Counts every edge without a matching reverse from scratch and
+// records the one way edges into every node
+void Graph::RecountAsymmetric() {
+	asymmetric = 0;
+	oneWayIn.assign(adjList.size(), std::vector<NodeID>());
+	
+	for (NodeID i = 0; i < adjList.size(); i++) {
+		for (int j = 0; j < adjList[i].GetDegree(); j++) {
+			const Node & end = adjList[adjList[i].GetTarget(j)];
+			int reverse = end.GetEdgeIndex(i);
+			
+			if (reverse == -1 || end.GetWeight(reverse) != adjList[i].GetWeight(j)) {
+				asymmetric++;
+			}
 			
-			++i;
+			if (reverse == -1) {
+				oneWayIn[adjList[i].GetTarget(j)].push_back(i);
+			}
 		}
 	}
 	
-	// Swap the lowest elements and the last element
-	temp = edges[i];
-	edges[i] = edges[high];
-	edges[high] = temp;
-	
-	return i;
+	return;
 }
 
-// GetSortedEdges
-// Gathers and sorts a list of all edges
-EdgeList Graph::GetSortedEdges() const {
-	EdgeList e;
+// InsertMSTEdge
+// params:
+//	nodeOne: This is the node at one end of the new or lighter edge
+//	nodeTwo: This is the node at the other end of the new or lighter edge
+// Repairs the MSF after an edge between the nodes was added or got
+// lighter. If the edge closes a cycle in the forest it replaces the
+// heaviest edge on that cycle when it is lighter.
+void Graph::InsertMSTEdge(NodeID nodeOne, NodeID nodeTwo) {
+	std::vector<NodeID> parents(adjList.size(), -1), stack(1, nodeOne);
+	Weight weight;
 	
-	// For every node in the adjacency list
-	for (int i = 0; i < adjList.size(); i++) {
-		// Get the nodes edges
-		EdgeList tmp = adjList[i].GetEdges();
+	GetPairWeight(nodeOne, nodeTwo, weight);
+	
+	// A forest edge that gets lighter keeps the forest minimum
+	if (mst[nodeOne].ContainsEdge(nodeTwo)) {
+		mst[nodeOne].UpdateEdge(nodeTwo, nodeTwo, false, weight);
+		mst[nodeTwo].UpdateEdge(nodeOne, nodeOne, false, weight);
+		return;
+	}
+	
+	// Walk the tree holding the first node until the second is found
+	parents[nodeOne] = nodeOne;
+	while (!stack.empty() && parents[nodeTwo] == -1) {
+		NodeID node = stack.back();
+		stack.pop_back();
+		
+		for (int i = 0; i < mst[node].GetDegree(); i++) {
+			NodeID next = mst[node].GetTarget(i);
+			
+			if (parents[next] == -1) {
+				parents[next] = node;
+				stack.push_back(next);
+			}
+		}
+	}
+	
+	// Edges are compared in KruskalOrder from their smaller end so the
+	// forest is always the one KruskalsAlgorithm would build
+	Edge added(std::min(nodeOne, nodeTwo), std::max(nodeOne, nodeTwo), weight), heaviest = added;
+	
+	// If the nodes are in the same tree find the heaviest edge on the cycle
+	if (parents[nodeTwo] != -1) {
+		for (NodeID node = nodeTwo; node != nodeOne; node = parents[node]) {
+			const Node & child = mst[node];
+			Edge onPath(std::min(node, parents[node]), std::max(node, parents[node]), child.GetWeight(child.GetEdgeIndex(parents[node])));
+			
+			if (CsrGraph::KruskalOrder(heaviest, onPath)) {
+				heaviest = onPath;
+			}
+		}
+		
+		// If the new edge is the heaviest the forest stays as it is
+		if (heaviest.GetStartID() == added.GetStartID() && heaviest.GetID() == added.GetID()) {
+			return;
+		}
 		
-		// Compile them with the other edges
-		e.insert(e.begin(), tmp.begin(), tmp.end());
+		mst[heaviest.GetStartID()].RemoveEdge(heaviest.GetID());
+		mst[heaviest.GetID()].RemoveEdge(heaviest.GetStartID());
 	}
 	
-	// Sort the edges
-	QuickSort(e, 0, e.size() - 1);
+	mst[nodeOne].AddEdge(nodeTwo, weight);
+	mst[nodeTwo].AddEdge(nodeOne, weight);
 	
-	return e;
+	return;
 }
 
-// PrimsAlgorithm
+// DeleteMSTEdge
 // params:
-//	start: This is the starting node for the produced MSF
-// Runs Prim's Algorithm on the graph and returns the produced MSF
-AdjList Graph::PrimsAlgorithm(NodeID start) const {
-	AdjList mst;
-	EdgeList n;
-	Heap <PrimsNode> nodes;
-	PrimsNode temp, min, updated;
-	float costs[adjList.size()];
-	bool visited[adjList.size()];
-	int edgeCounter = 0;
-	
-	// Clamp start inside the bounds of the graphs
-	if (start < 0 || start >= adjList.size())
-		start = 0;
-	
-	// For every vertice
-	for (int i = 0; i < adjList.size(); i++) {
-		// Push back every node
-		mst.push_back(Node(i));
-		
-		// Prepare them for prims algorithm
-		temp.node = adjList[i].GetID();
-		
-		// If this is the starting node
-		if (i == start) {
-			// Set this node to root values
-			temp.cost = 0;
-			costs[i] = 0;
-		} else {
-			// Set the costs to infinity
-			temp.cost = INFINITY;
-			costs[i] = INFINITY;
+//	nodeOne: This is the node at one end of the removed edge
+//	nodeTwo: This is the node at the other end of the removed edge
+// Repairs the MSF after every edge between the nodes was removed. If
+// it was a forest edge the smaller of the two trees left is searched
+// for the lightest edge that joins them back together.
+void Graph::DeleteMSTEdge(NodeID nodeOne, NodeID nodeTwo) {
+	std::vector<signed char> & tree = mstTree;
+	std::vector<NodeID> trees[2];
+	int next[2] = { 0, 0 }, smaller = -1;
+	bool found = false;
+	Edge best(0, 0);
+	
+	// If the pair was not in the forest nothing changes
+	if (!mst[nodeOne].RemoveEdge(nodeTwo)) {
+		return;
+	}
+	
+	mst[nodeTwo].RemoveEdge(nodeOne);
+	
+	// Nodes added since the last repair start outside both trees
+	if (tree.size() < adjList.size()) {
+		tree.resize(adjList.size(), -1);
+	}
+	
+	// Grow both trees a node at a time, the first to run out is the smaller
+	trees[0].push_back(nodeOne);
+	trees[1].push_back(nodeTwo);
+	tree[nodeOne] = 0;
+	tree[nodeTwo] = 1;
+	
+	while (smaller == -1) {
+		for (int t = 0; t < 2 && smaller == -1; t++) {
+			if (next[t] == trees[t].size()) {
+				smaller = t;
+			} else {
+				const Node & node = mst[trees[t][next[t]++]];
+				
+				for (int i = 0; i < node.GetDegree(); i++) {
+					if (tree[node.GetTarget(i)] == -1) {
+						tree[node.GetTarget(i)] = t;
+						trees[t].push_back(node.GetTarget(i));
+					}
+				}
+			}
+		}
+	}
+	
+	// Edges stored only in the larger tree can also join them when not every
+	// edge has a matching reverse, so then that tree has to be walked too
+	int larger = 1 - smaller, scanned = 1;
+	if (asymmetric > 0) {
+		while (next[larger] < trees[larger].size()) {
+			const Node & node = mst[trees[larger][next[larger]++]];
+			
+			for (int i = 0; i < node.GetDegree(); i++) {
+				if (tree[node.GetTarget(i)] == -1) {
+					tree[node.GetTarget(i)] = larger;
+					trees[larger].push_back(node.GetTarget(i));
+				}
+			}
 		}
 		
-		// Set the nodes to not being visited
-		visited[i] = false;
-		// And the parents to themselves
-		temp.parent = i;
-		
-		nodes.Push(temp);
+		scanned = 2;
 	}
 	
-	// While we don't have V-1 edges in our MST
-	while (edgeCounter < adjList.size() - 1) {
-		// Get the node with the minimum cost and its neighbors
-		min = nodes.Pop();
-		n = adjList[min.node].GetEdges();
+	// Find the lightest edge in KruskalOrder leaving one tree for the other
+	for (int t = 0; t < scanned; t++) {
+		int from = (t == 0 ? smaller : larger);
 		
-		// If this node has not already been visited
-		if (!visited[min.node]) {
-			visited[min.node] = true;
+		for (int i = 0; i < trees[from].size(); i++) {
+			const Node & node = adjList[trees[from][i]];
 			
-			// If this node is not the root node
-			if (min.node != start) {
-				// Add a bidirectional connection between the two points
-				mst[min.parent].AddEdge(min.node, min.cost);
-				mst[min.node].AddEdge(min.parent, min.cost);
+			for (int j = 0; j < node.GetDegree(); j++) {
+				NodeID start = trees[from][i], end = node.GetTarget(j);
 				
-				// Increment the edge counter
-				edgeCounter++;
-			}
-			
-			// For every neighbor to this node
-			for (int i = 0; i < n.size(); i++) {
-				// If this node has not been visited already and if
-				// the cost of the current weight plus the edge is better
-				if (!visited[n[i].GetID()] && (min.cost + n[i].GetWeight()) < costs[n[i].GetID()]) {
-					// Create a new node with the updated values
-					updated.node = n[i].GetID();
-					updated.parent = min.node;
-					updated.cost = min.cost + n[i].GetWeight();
-					
-					// Update the cost values
-					costs[n[i].GetID()] = min.cost + n[i].GetWeight();
+				// Every neighbor of the whole tree outside the smaller tree is in the other one
+				if (tree[end] != from && (t == 0 || tree[end] == smaller)) {
+					Edge joining(std::min(start, end), std::max(start, end), node.GetWeight(j));
 					
-					// Push the new node to the heap
-					nodes.Push(updated);
+					if (!found || CsrGraph::KruskalOrder(joining, best)) {
+						best = joining;
+						found = true;
+					}
 				}
 			}
 		}
 	}
 	
-	return mst;
-}
-
-// KruskalsAlgorithm
-// Performs Kruskals Algorithm on the current state of the
-// graph and returns an EdgeList that makes a MSF
-AdjList Graph::KruskalsAlgorithm() const {
-	AdjList mst;
-	EdgeList e = GetSortedEdges();
-	
-	// Initialize an adjancy list for the MST
-	for (int i = 0; i < adjList.size(); i++) {
-		// Push back every node
-		mst.push_back(Node(i));
+	// Join the trees back together with the replacement
+	if (found) {
+		mst[best.GetStartID()].AddEdge(best.GetID(), best.GetWeight());
+		mst[best.GetID()].AddEdge(best.GetStartID(), best.GetWeight());
 	}
 	
-	// Create a UnionFind DS with the size of the amount of nodes
-	UnionFind ufn(adjList.size());
+	// Only the nodes of the two trees were marked, so only they are reset
+	for (int t = 0; t < 2; t++) {
+		for (int i = 0; i < trees[t].size(); i++) {
+			tree[trees[t][i]] = -1;
+		}
+	}
 	
-	// For every edge in the sorted edges list
-	for (int i = 0; i < e.size(); i++) {
-		// Find the set that each point belongs to
-		NodeID x = ufn.Find(e[i].GetStartID()),
-			   y = ufn.Find(e[i].GetID());
+	return;
+}
+
+// MaintainMST
+// params:
+//	maintain: Is a flag if the MSF should be kept up to date
+// Turning this on builds the MSF once, after which AddEdge and
+// RemoveEdge repair it in place instead of it being rebuilt. Turning
+// it off releases the MSF.
+void Graph::MaintainMST(bool maintain) {
+	// If the MSF is starting to be maintained build it
+	if (maintain && !maintainMST) {
+		AdjList forest = KruskalsAlgorithm();
 		
-		// If the points are not in the same set
-		if (x != y) {
-			// Merge the sets
-			ufn.Union(x, y);
-			
-			// Add a bidirectional connection between the two points
-			mst[e[i].GetStartID()].AddEdge(e[i].GetID(), e[i].GetWeight());
-			mst[e[i].GetID()].AddEdge(e[i].GetStartID(), e[i].GetWeight());
+		// Copy it into our arena like the rest of the graph
+		mst.clear();
+		mst.reserve(forest.size());
+		for (NodeID i = 0; i < forest.size(); i++) {
+			CopyNode(mst, forest[i], NULL);
 		}
+	} else if (!maintain) {
+		AdjList().swap(mst);
 	}
 	
+	maintainMST = maintain;
+	
+	return;
+}
+
+// IsMaintainingMST
+// Returns true if the MSF is being kept up to date
+bool Graph::IsMaintainingMST() const {
+	return maintainMST;
+}
+
+// GetMST
+// Returns the maintained MSF, which holds the same edges as the one
+// KruskalsAlgorithm builds. It is empty when the MSF is not maintained.
+const AdjList & Graph::GetMST() const {
 	return mst;
 }
 
@@ -392,7 +938,12 @@ AdjList Graph::KruskalsAlgorithm() const {
 // Prints the adjacency list of this graph
 void Graph::Print() const {
 	// For every node in the adjacency list
-	for (int i = 0; i < adjList.size(); i++) {
+	for (NodeID i = 0; i < adjList.size(); i++) {
+		// Skip the tombstones of removed nodes
+		if (removed[i]) {
+			continue;
+		}
+		
 		// Print the node
 		adjList[i].Print();
 
@@ -2,33 +2,49 @@
 #define GRAPH_H
 
 #include <vector> // For the vector class
+#include <memory> // For the unique_ptr class
 #include "Node.h" // For the node class
-
-typedef std::vector<Node> AdjList;
+#include "CsrGraph.h" // For the CsrGraph class
+#include "PathQuery.h" // For the PathQuery class
 
 // Graph
 // This is a class that represents a graph. Nodes can be added and directional
 // and bidirectional links with weights can be added between any two nodes.
+// The edges of every node are kept in an EdgeArena owned by the graph.
 class Graph {
 	private:
+		std::unique_ptr<EdgeArena> arena; // This holds the edges of every node, declared first so it outlives them
 		AdjList adjList; // This is the adjancency list
-		int vertices, edges; // These are the counts of vertices and edges
-		
-		// Prims node
-		// This is a data structure used when Prims Algorithm is ran
-		struct PrimsNode {
-			NodeID node;
-			NodeID parent;
-			float cost;
-			
-			// Operator > Overload
-			// params:
-			//	pn: This is the PrimsNode we are comapring against
-			// Performs a greater than check between this and the passed PrimsNode
-			bool operator > (const PrimsNode & pn) const {
-				return (cost > pn.cost);
-			}
-		};
+		NodeID vertices; // This is the count of vertices
+		EdgeIndex edges; // This is the count of edges
+		std::vector<bool> removed; // Is a flag for every ID if its node was removed
+		EdgeIndex asymmetric; // This is the amount of edges whose reverse is missing or weighs differently
+		std::vector<std::vector<NodeID> > oneWayIn; // The nodes with an edge into every node that had no reverse when it was added
+		
+		// These are only used while the MSF is maintained
+		bool maintainMST; // Is a flag if the MSF is kept up to date
+		AdjList mst;      // This is the maintained MSF
+		std::vector<signed char> mstTree; // The tree of every node while the MSF is repaired, -1 between repairs
+		
+		// These are built by the first query and kept for the next ones until
+		// the graph changes
+		mutable std::unique_ptr<CsrGraph> pathGraph;    // The snapshot the queries search
+		mutable std::unique_ptr<CsrGraph> pathIncoming; // Its Transpose, NULL when every edge has a reverse
+		mutable std::unique_ptr<PathQuery> pathQuery;   // The query reused for every search
+		
+		// GetSnapshot
+		// Returns the cached snapshot, freezing the graph and building the
+		// Transpose when one is needed if the graph changed since the last query
+		const CsrGraph & GetSnapshot() const;
+		
+		// GetPathQuery
+		// Returns the cached path query, building it and its snapshot if the
+		// graph changed since the last query
+		PathQuery & GetPathQuery() const;
+		
+		// DropPathQuery
+		// Releases the cached path query, called whenever the graph changes
+		void DropPathQuery();
 		
 		// ContainsPair
 		// params:
@@ -41,48 +57,126 @@ class Graph {
 		// params:
 		//	node: This is the node we wish to find
 		// Finds the given node and returns its index
-		int GetIndex(NodeID node) const;
+		NodeID GetIndex(NodeID node) const;
 		
-		// Quicksort
+		// GetPairWeight
 		// params:
-		//	edges: This is the list of edges to sort
-		//	size: This is the size of the array in which is being sorted
-		// Performs the Quicksort algorithm on the list of edges
-		void QuickSort(EdgeList & edges, const int & low, const int & high) const;
-
-		// Partition
+		//	nodeOne: This is the node at one end of the pair
+		//	nodeTwo: This is the node at the other end of the pair
+		//	weight: This is set to the weight of the lighter edge between them
+		// Returns true if there is an edge between the nodes in either direction
+		bool GetPairWeight(NodeID nodeOne, NodeID nodeTwo, Weight & weight) const;
+		
+		// CountAsymmetric
 		// params:
-		//	edges: This is the list of edges to sort
-		//	low: This is the lower bound index in the array to partition
-		//	high: This is the higher bound index in the array to partition
-		// Takes the edges and returns a partition point used in the Quick sort algorithm
-		int Partition(EdgeList & edges, const int & low, const int & high) const;
+		//	nodeOne: This is the node at one end of the pair
+		//	nodeTwo: This is the node at the other end of the pair
+		// Returns how many of the edges between the nodes have no reverse
+		// edge of the same weight
+		int CountAsymmetric(NodeID nodeOne, NodeID nodeTwo) const;
 		
-		// GetSortedEdges
-		// Gathers and sorts a list of all edges
-		EdgeList GetSortedEdges() const;
+		// CopyNode
+		// params:
+		//	list: This is the list the copy is added to
+		//	old: This is the node being copied
+		//	newIDs: This is the new ID of every old ID, NULL keeps the IDs
+		// Adds a copy of the node to the list with its edges in our arena
+		void CopyNode(AdjList & list, const Node & old, const std::vector<NodeID> * newIDs);
 		
+		// DropOneWayIn
+		// params:
+		//	node: This is the node the edge went into
+		//	source: This is the node the edge came from
+		// Forgets the one way edge from the source into the node, if recorded
+		void DropOneWayIn(NodeID node, NodeID source);
+		
+		// RecountAsymmetric
+		// Counts every edge without a matching reverse from scratch and
+		// records the one way edges into every node
+		void RecountAsymmetric();
+		
+		// InsertMSTEdge
+		// params:
+		//	nodeOne: This is the node at one end of the new or lighter edge
+		//	nodeTwo: This is the node at the other end of the new or lighter edge
+		// Repairs the MSF after an edge between the nodes was added or got
+		// lighter. If the edge closes a cycle in the forest it replaces the
+		// heaviest edge on that cycle when it is lighter.
+		void InsertMSTEdge(NodeID nodeOne, NodeID nodeTwo);
+		
+		// DeleteMSTEdge
+		// params:
+		//	nodeOne: This is the node at one end of the removed edge
+		//	nodeTwo: This is the node at the other end of the removed edge
+		// Repairs the MSF after every edge between the nodes was removed. If
+		// it was a forest edge the smaller of the two trees left is searched
+		// for the lightest edge that joins them back together.
+		void DeleteMSTEdge(NodeID nodeOne, NodeID nodeTwo);
+		
+		friend class GraphBuilder;
+	
 	public:
 		//Default constructor
 		Graph();
 		
+		// Copy Constructor
+		// params:
+		//	graph: This is the graph being copied
+		// Copies the graph into an arena of its own, without the region
+		Graph(const Graph & graph);
+		
+		// Destructor
+		// Releases the edges of every node at once
+		~Graph();
+		
+		// operator= Overload
+		// params:
+		//	graph: This is the graph being copied
+		// Replaces this graph with a copy of the graph, keeping our region
+		Graph & operator=(const Graph & graph);
+		
+		// UseRegion
+		// params:
+		//	region: This is the start of the memory to use, NULL for none
+		//	size: This is the size of the memory in bytes
+		// Places the edges of every node in memory the caller owns, such as
+		// huge pages, until it runs out. The memory has to outlive the graph
+		// and is used again after Clear. Returns false if the graph has nodes.
+		bool UseRegion(void * region, std::size_t size);
+		
 		// GetNumVertices
-		// Returns the number of vertices in the graph
-		int GetNumVertices() const;
+		// Returns the number of vertices in the graph, removed ones excluded
+		NodeID GetNumVertices() const;
 		
 		// GetNumEdges
 		// Returns the number of edges in the graph
-		int GetNumEdges() const;
+		EdgeIndex GetNumEdges() const;
 		
 		// AddNode
 		// Add the node to the adjacency list, returns the new nodes ID
-		int AddNode();
+		NodeID AddNode();
 		
 		// RemoveNode
 		// params:
 		//	node: This is the node we wish to remove from the graph
-		// Removes the node from the adjancy list, if it exists
-		//bool RemoveNode(NodeID node);
+		// Removes the node and every edge touching it, returns false if the
+		// node does not exist. Only the edges of the node, their reverses and
+		// the one way edges recorded into it are touched, so it costs O(degree)
+		// on directed graphs as well. The ID is left as a tombstone and not
+		// reused until Compact, every other ID stays the same, and snapshots
+		// keep it as a node with no edges.
+		bool RemoveNode(NodeID node);
+		
+		// Compact
+		// Renumbers the nodes left so the IDs are dense again and releases
+		// the memory held by removed nodes, in one pass over the edges. The
+		// nodes keep their order. Returns the new ID of every old ID, -1 for
+		// the removed ones, so IDs held elsewhere can be updated.
+		std::vector<NodeID> Compact();
+		
+		// GetNumRemoved
+		// Returns the number of removed node IDs that Compact would reclaim
+		NodeID GetNumRemoved() const;
 		
 		// AddEdge
 		// params:
@@ -92,7 +186,7 @@ class Graph {
 		//	directed: This is a flag if the link is bidirectional or not
 		// Adds the edge between the start and end node, if directional is false
 		// then an edge will be added between end and start as well.
-		bool AddEdge(NodeID startID, NodeID endID, float weight = 0, bool directed = false);
+		bool AddEdge(NodeID startID, NodeID endID, Weight weight = 0, bool directed = false);
 		
 		// RemoveEdge
 		// params:
@@ -108,6 +202,13 @@ class Graph {
 		// Returns an EdgeList with all neighbors for that node
 		EdgeList GetNodeEdges(NodeID node) const;
 		
+		// GetNodeNeighbors
+		// params:
+		//	node: This is the node for whose neighbors we want
+		// Returns a view over the neighbors of that node without copying
+		// them, the view is empty if the node does not exist
+		NeighborRange GetNodeNeighbors(NodeID node) const;
+		
 		// Contains
 		// params:
 		//	node: This is the node we are looking for
@@ -115,20 +216,174 @@ class Graph {
 		bool Contains(NodeID node) const;
 		
 		// Clear
-		// Resets all values used to by the graph to a default value
+		// Resets all values used to by the graph to a default value. The
+		// edges of every node are released at once rather than one by one.
 		void Clear();
 		
+		// Freeze
+		// Packs the current state of the graph into an immutable CsrGraph
+		// snapshot that the graph algorithms can run on directly, with every
+		// nodes neighbors sorted by ID
+		CsrGraph Freeze() const;
+		
 		// PrimsAlgorithm
 		// params:
 		//	start: This is the starting node for the produced MSF
 		// Runs Prim's Algorithm on the graph and returns the produced MSF
 		AdjList PrimsAlgorithm(NodeID start = 0) const;
 		
+		// PrimsAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the produced MSF
+		//	start: This is the starting node for the produced MSF
+		// Runs Prim's Algorithm on the current state of the graph without
+		// building an adjacency list
+		void PrimsAlgorithm(SpanningForest & forest, NodeID start = 0) const;
+		
+		// PrimsAlgorithm
+		// params:
+		//	parents: This is filled with the parent of every node in the MSF
+		//	start: This is the starting node for the produced MSF
+		// Runs Prim's Algorithm on the current state of the graph and returns
+		// the weight of the MSF. The root of every tree is its own parent.
+		Weight PrimsAlgorithm(std::vector<NodeID> & parents, NodeID start = 0) const;
+		
 		// KruskalsAlgorithm
 		// Performs Kruskals Algorithm on the current state of the
 		// graph and returns an EdgeList that makes a MSF
 		AdjList KruskalsAlgorithm() const;
 		
+		// KruskalsAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		// Performs Kruskals Algorithm on the current state of the graph
+		// without building an adjacency list
+		void KruskalsAlgorithm(SpanningForest & forest) const;
+		
+		// FilterKruskalAlgorithm
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs the Filter-Kruskal Algorithm on the current state of the
+		// graph and returns the same MSF as KruskalsAlgorithm
+		AdjList FilterKruskalAlgorithm(int threads = 0) const;
+		
+		// FilterKruskalAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs the Filter-Kruskal Algorithm on the current state of the
+		// graph without building an adjacency list
+		void FilterKruskalAlgorithm(SpanningForest & forest, int threads = 0) const;
+		
+		// BoruvkaAlgorithm
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs Boruvkas Algorithm on the current state of the graph
+		// using every core and returns the same MSF as KruskalsAlgorithm
+		AdjList BoruvkaAlgorithm(int threads = 0) const;
+		
+		// BoruvkaAlgorithm
+		// params:
+		//	forest: This is filled with the edges of the MSF in KruskalOrder
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Performs Boruvkas Algorithm on the current state of the graph
+		// without building an adjacency list
+		void BoruvkaAlgorithm(SpanningForest & forest, int threads = 0) const;
+		
+		// Dijkstra
+		// params:
+		//	source: This is the node the search starts from
+		//	queue: This is the priority queue to run on, defaulted to the IndexedHeap
+		// Runs Dijkstras Algorithm on the current state of the graph and returns
+		// the distance to and parent of every node. Freeze the graph once and
+		// search the CsrGraph instead when running many searches.
+		ShortestPathTree Dijkstra(NodeID source, ShortestPathQueue queue = IndexedHeapQueue) const;
+		
+		// Dijkstra
+		// params:
+		//	source: This is the node the search starts from
+		//	target: This is the node the search stops at
+		//	queue: This is the priority queue to run on, defaulted to the IndexedHeap
+		// Runs Dijkstras Algorithm on the current state of the graph and stops as
+		// soon as the target is settled, only its distance and path are final
+		ShortestPathTree Dijkstra(NodeID source, NodeID target, ShortestPathQueue queue = IndexedHeapQueue) const;
+		
+		// DeltaStepping
+		// params:
+		//	source: This is the node the search starts from
+		//	delta: This is the width of each bucket, 0 picks one from the weights
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Runs the parallel delta-stepping shortest path algorithm on the current
+		// state of the graph and returns the same distances as Dijkstra
+		ShortestPathTree DeltaStepping(NodeID source, Weight delta = 0, int threads = 0) const;
+		
+		// BreadthFirstSearch
+		// params:
+		//	source: This is the node the search starts from
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Runs a direction optimizing breadth first search on the current state
+		// of the graph and returns the level and parent of every node. It
+		// searches the snapshot ShortestPath uses, so it must not run at the
+		// same time as other queries on the graph.
+		BreadthFirstTree BreadthFirstSearch(NodeID source, int threads = 0) const;
+		
+		// ConnectedComponents
+		// params:
+		//	threads: This is the amount of threads to use, 0 uses every core
+		// Labels every node of the current state of the graph with its weakly
+		// connected component, directed edges join nodes as if they went both
+		// ways. Returns the label of every node, which is the smallest node ID
+		// in its component. It uses the snapshot ShortestPath uses, so it must
+		// not run at the same time as other queries on the graph.
+		std::vector<NodeID> ConnectedComponents(int threads = 0) const;
+		
+		// ShortestPath
+		// params:
+		//	source: This is the node the path starts at
+		//	target: This is the node the path ends at
+		//	path: This is filled with the nodes on the path if it is not NULL
+		// Runs a bidirectional Dijkstra on the current state of the graph and
+		// returns the length of the shortest path, infinite if there is none.
+		// The snapshot and workspace are built by the first query and reused
+		// until the graph changes, so queries on the same graph must not run
+		// at the same time. Use a PathQuery per thread for that.
+		Weight ShortestPath(NodeID source, NodeID target, std::vector<NodeID> * path = NULL) const;
+		
+		// AStar
+		// params:
+		//	source: This is the node the path starts at
+		//	target: This is the node the path ends at
+		//	heuristic: This is called as heuristic(node) and returns a lower
+		//	           bound on the distance from the node to the target
+		//	path: This is filled with the nodes on the path if it is not NULL
+		// Runs an A* search on the current state of the graph and returns the
+		// length of the shortest path, infinite if there is none. It reuses
+		// the same workspace as ShortestPath.
+		template <class Heuristic>
+		Weight AStar(NodeID source, NodeID target, Heuristic heuristic, std::vector<NodeID> * path = NULL) const {
+			return GetPathQuery().AStar(source, target, heuristic, path);
+		}
+		
+		// MaintainMST
+		// params:
+		//	maintain: Is a flag if the MSF should be kept up to date
+		// Turning this on builds the MSF once, after which AddEdge and
+		// RemoveEdge repair it in place instead of it being rebuilt. An edge
+		// that closes a cycle swaps out the heaviest edge on it and removing a
+		// forest edge only searches for its replacement. Directed edges count
+		// as going both ways with the lighter weight, as in KruskalsAlgorithm.
+		// Turning it off releases the MSF.
+		void MaintainMST(bool maintain = true);
+		
+		// IsMaintainingMST
+		// Returns true if the MSF is being kept up to date
+		bool IsMaintainingMST() const;
+		
+		// GetMST
+		// Returns the maintained MSF, which holds the same edges as the one
+		// KruskalsAlgorithm builds. It is empty when the MSF is not maintained.
+		const AdjList & GetMST() const;
+		
 		// Print
 		// Prints the adjacency list of this graph
 		void Print() const;
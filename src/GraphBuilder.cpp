@@ -0,0 +1,284 @@
+#include <algorithm> // For the stable_sort function
+#include "Parallel.h"
+#include "GraphBuilder.h"
+
+// Parameterized Constructor
+// params:
+//	directed: This is a flag if edges are added in one direction only
+// Creates an empty builder, undirected edges are symmetrized
+GraphBuilder::GraphBuilder(bool directed) : vertices(0), directed(directed) {
+	return;
+}
+
+// SetNumVertices
+// params:
+//	vertices: This is the amount of nodes the built graph should have
+// Grows the built graph to at least this many nodes, nodes are also
+// added automatically to fit the largest ID seen in an edge
+void GraphBuilder::SetNumVertices(NodeID vertices) {
+	if (vertices > this->vertices) {
+		this->vertices = vertices;
+	}
+	
+	return;
+}
+
+// GetNumVertices
+// Returns the number of nodes the built graph will have
+NodeID GraphBuilder::GetNumVertices() const {
+	return vertices;
+}
+
+// GetNumEdges
+// Returns the number of edges in the batch
+EdgeIndex GraphBuilder::GetNumEdges() const {
+	return edges.size();
+}
+
+// Reserve
+// params:
+//	count: This is the amount of edges that will be added
+// Sizes the batch up front so adding edges does not reallocate
+void GraphBuilder::Reserve(EdgeIndex count) {
+	edges.reserve(count);
+	return;
+}
+
+// AddEdge
+// params:
+//	startID: This is the node id of the starting node
+//	endID: This is the node id of the ending node
+//	weight: This is the weight associated with this link
+// Adds an edge to the batch, returns false if an ID is negative
+bool GraphBuilder::AddEdge(NodeID startID, NodeID endID, Weight weight) {
+	bool added = false;
+	
+	// If both IDs are valid
+	if (startID >= 0 && endID >= 0) {
+		edges.push_back(Edge(startID, endID, weight));
+		
+		// Grow the graph to fit both nodes
+		SetNumVertices((startID > endID ? startID : endID) + 1);
+		
+		added = true;
+	}
+	
+	return added;
+}
+
+// AddEdges
+// params:
+//	first: This is the first edge to add
+//	last: This is one past the last edge to add
+// Adds every edge in the range to the batch
+void GraphBuilder::AddEdges(const Edge * first, const Edge * last) {
+	edges.reserve(edges.size() + (last - first));
+	
+	// For every edge in the range
+	for (const Edge * e = first; e != last; ++e) {
+		AddEdge(e->GetStartID(), e->GetID(), e->GetWeight());
+	}
+	
+	return;
+}
+
+// Clear
+// Removes every edge from the batch
+void GraphBuilder::Clear() {
+	edges.clear();
+	vertices = 0;
+	
+	return;
+}
+
+// Pack
+// params:
+//	offsets: This is filled with the start of each nodes neighbors
+//	targets: This is filled with the end node of every edge
+//	weights: This is filled with the weight of every edge
+// Packs the batch of edges into compressed sparse row arrays
+void GraphBuilder::Pack(std::vector<EdgeIndex> & offsets, std::vector<NodeID> & targets, std::vector<Weight> & weights) const {
+	const int threads = GetNumThreads();
+	std::vector<EdgeIndex> start(vertices + 1), kept(vertices);
+	std::vector<EdgeIndex> cursor((uint64_t)vertices * threads, 0); // The slots of every thread within every node, a row per thread
+	std::vector<PackedEdge> packed;
+	const Edge * batch = edges.data();
+	bool symmetric = !directed;
+	
+	// Every thread counts the edges of its slice of the batch for every
+	// node, skipping self loops
+	ParallelFor(0, edges.size(), [&](int thread, uint64_t first, uint64_t last) {
+		EdgeIndex * counts = cursor.data() + (uint64_t)vertices * thread;
+		
+		for (uint64_t i = first; i < last; i++) {
+			if (batch[i].GetStartID() != batch[i].GetID()) {
+				counts[batch[i].GetStartID()]++;
+				
+				if (symmetric) {
+					counts[batch[i].GetID()]++;
+				}
+			}
+		}
+	}, threads);
+	
+	// Add up the degree of every node
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			EdgeIndex degree = 0;
+			
+			for (int t = 0; t < threads; t++) {
+				degree += cursor[(uint64_t)vertices * t + i];
+			}
+			
+			start[i + 1] = degree;
+		}
+	});
+	
+	// Turn the degrees into the start of every nodes slots
+	start[0] = 0;
+	for (NodeID i = 0; i < vertices; i++) {
+		start[i + 1] += start[i];
+	}
+	
+	// Within every node the slices of the batch follow each other, so
+	// turn the counts into where each thread writes
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			EdgeIndex next = start[i];
+			
+			for (int t = 0; t < threads; t++) {
+				EdgeIndex count = cursor[(uint64_t)vertices * t + i];
+				
+				cursor[(uint64_t)vertices * t + i] = next;
+				next += count;
+			}
+		}
+	});
+	
+	// Scatter every slice into the slots of its nodes, the slices line up
+	// with the counting pass so every node is filled in batch order
+	packed.resize(start[vertices]);
+	ParallelFor(0, edges.size(), [&](int thread, uint64_t first, uint64_t last) {
+		EdgeIndex * next = cursor.data() + (uint64_t)vertices * thread;
+		
+		for (uint64_t i = first; i < last; i++) {
+			NodeID s = batch[i].GetStartID(), e = batch[i].GetID();
+			
+			if (s != e) {
+				PackedEdge & forward = packed[next[s]++];
+				forward.target = e;
+				forward.weight = batch[i].GetWeight();
+				
+				if (symmetric) {
+					PackedEdge & backward = packed[next[e]++];
+					backward.target = s;
+					backward.weight = batch[i].GetWeight();
+				}
+			}
+		}
+	}, threads);
+	
+	// Sort every nodes slots, keeping duplicates in batch order, and drop
+	// all but the first copy of each edge
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			PackedEdge * begin = packed.data() + start[i], * end = packed.data() + start[i + 1];
+			EdgeIndex count = 0;
+			
+			std::stable_sort(begin, end);
+			
+			for (PackedEdge * pe = begin; pe != end; ++pe) {
+				if (count == 0 || begin[count - 1].target != pe->target) {
+					begin[count++] = *pe;
+				}
+			}
+			
+			kept[i] = count;
+		}
+	});
+	
+	// Lay out the final offsets
+	offsets.resize(vertices + 1);
+	offsets[0] = 0;
+	for (NodeID i = 0; i < vertices; i++) {
+		offsets[i + 1] = offsets[i] + kept[i];
+	}
+	
+	// Copy the kept edges into place
+	targets.resize(offsets[vertices]);
+	weights.resize(WeightedEdges ? offsets[vertices] : 0);
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			for (EdgeIndex j = 0; j < kept[i]; j++) {
+				targets[offsets[i] + j] = packed[start[i] + j].target;
+				
+				if (WeightedEdges) {
+					weights[offsets[i] + j] = packed[start[i] + j].weight;
+				}
+			}
+		}
+	});
+	
+	return;
+}
+
+// BuildCsr
+// Builds an immutable CsrGraph from the batch of edges
+CsrGraph GraphBuilder::BuildCsr() const {
+	CsrGraph csr;
+	
+	Pack(csr.offsetStorage, csr.targetStorage, csr.weightStorage);
+	csr.BindStorage();
+	
+	return csr;
+}
+
+// Build
+// params:
+//	graph: This is the graph that will hold the built edges
+// Replaces the contents of the graph with the batch of edges
+void GraphBuilder::Build(Graph & graph) const {
+	std::vector<EdgeIndex> offsets;
+	std::vector<NodeID> targets;
+	std::vector<Weight> weights;
+	bool maintainMST = graph.maintainMST;
+	
+	Pack(offsets, targets, weights);
+	
+	// Create every node up front with its edges sized exactly once, here
+	// as the graphs arena is not thread safe
+	graph.Clear();
+	graph.adjList.reserve(vertices);
+	for (NodeID i = 0; i < vertices; i++) {
+		graph.adjList.push_back(Node(i, graph.arena.get()));
+		graph.adjList.back().ReserveEdges(offsets[i + 1] - offsets[i]);
+	}
+	
+	// Fill every nodes edges
+	ParallelFor(0, vertices, [&](int thread, uint64_t first, uint64_t last) {
+		for (uint64_t i = first; i < last; i++) {
+			Node & node = graph.adjList[i];
+			
+			for (EdgeIndex j = offsets[i]; j < offsets[i + 1]; j++) {
+				node.AppendEdge(targets[j], (WeightedEdges ? weights[j] : 1));
+			}
+			
+			// High degree nodes get their neighbor index straight away
+			if (node.GetDegree() > Node::IndexThreshold) {
+				node.BuildIndex();
+			}
+		}
+	});
+	
+	graph.vertices = vertices;
+	graph.edges = offsets[vertices];
+	graph.removed.assign(vertices, false);
+	graph.RecountAsymmetric();
+	
+	// Clearing the graph stopped the MSF being maintained, so rebuild it
+	if (maintainMST) {
+		graph.MaintainMST();
+	}
+	
+	return;
+}
\ No newline at end of file
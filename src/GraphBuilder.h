@@ -0,0 +1,104 @@
+#ifndef GRAPH_BUILDER_H
+#define GRAPH_BUILDER_H
+
+#include <vector> // For the vector class
+#include "Graph.h" // For the Graph and CsrGraph classes
+
+// GraphBuilder
+// This class builds a graph from a large batch of edges at once. Rather
+// than validating and growing a node per AddEdge call, it counts every
+// nodes degree, sizes the storage once and fills the adjacency of every
+// node in parallel. Self loops are dropped and, like Graph::AddEdge, the
+// first copy of a duplicate edge wins.
+class GraphBuilder {
+	private:
+		EdgeList edges;  // This is the batch of edges waiting to be built
+		NodeID vertices; // This is the amount of nodes the built graph will have
+		bool directed;   // Is a flag if the edges are added in one direction only
+		
+		// PackedEdge
+		// This is a data structure used while the adjacency is being packed
+		struct PackedEdge {
+			NodeID target;
+			Weight weight;
+			
+			// Operator < Overload
+			// params:
+			//	pe: This is the PackedEdge we are comparing against
+			// Orders edges by their target, a stable sort keeps duplicates in
+			// the order they were added
+			bool operator < (const PackedEdge & pe) const {
+				return (target < pe.target);
+			}
+		};
+		
+		// Pack
+		// params:
+		//	offsets: This is filled with the start of each nodes neighbors
+		//	targets: This is filled with the end node of every edge
+		//	weights: This is filled with the weight of every edge
+		// Packs the batch of edges into compressed sparse row arrays
+		void Pack(std::vector<EdgeIndex> & offsets, std::vector<NodeID> & targets, std::vector<Weight> & weights) const;
+		
+		friend class EdgeListReader;
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	directed: This is a flag if edges are added in one direction only
+		// Creates an empty builder, undirected edges are symmetrized
+		GraphBuilder(bool directed = false);
+		
+		// SetNumVertices
+		// params:
+		//	vertices: This is the amount of nodes the built graph should have
+		// Grows the built graph to at least this many nodes, nodes are also
+		// added automatically to fit the largest ID seen in an edge
+		void SetNumVertices(NodeID vertices);
+		
+		// GetNumVertices
+		// Returns the number of nodes the built graph will have
+		NodeID GetNumVertices() const;
+		
+		// GetNumEdges
+		// Returns the number of edges in the batch
+		EdgeIndex GetNumEdges() const;
+		
+		// Reserve
+		// params:
+		//	count: This is the amount of edges that will be added
+		// Sizes the batch up front so adding edges does not reallocate
+		void Reserve(EdgeIndex count);
+		
+		// AddEdge
+		// params:
+		//	startID: This is the node id of the starting node
+		//	endID: This is the node id of the ending node
+		//	weight: This is the weight associated with this link
+		// Adds an edge to the batch, returns false if an ID is negative
+		bool AddEdge(NodeID startID, NodeID endID, Weight weight = 0);
+		
+		// AddEdges
+		// params:
+		//	first: This is the first edge to add
+		//	last: This is one past the last edge to add
+		// Adds every edge in the range to the batch
+		void AddEdges(const Edge * first, const Edge * last);
+		
+		// BuildCsr
+		// Builds an immutable CsrGraph from the batch of edges
+		CsrGraph BuildCsr() const;
+		
+		// Build
+		// params:
+		//	graph: This is the graph that will hold the built edges
+		// Replaces the contents of the graph with the batch of edges. If the
+		// graph was maintaining its MSF it is rebuilt for the new edges.
+		void Build(Graph & graph) const;
+		
+		// Clear
+		// Removes every edge from the batch
+		void Clear();
+}; // End GraphBuilder Class
+
+#endif
\ No newline at end of file
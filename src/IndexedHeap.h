@@ -0,0 +1,257 @@
+#ifndef INDEXED_HEAP_H
+#define INDEXED_HEAP_H
+
+#include <iostream> // For cout
+#include <vector> // For the vector class
+#include "Edge.h" // For the NodeID type
+
+// IndexedHeap
+// This is an implementation of a d-ary minimum heap over the integer IDs
+// 0 to capacity - 1, each with a key. A position map tracks where every
+// ID sits so its key can be lowered in place with DecreaseKey, which keeps
+// the heap no larger than the amount of IDs. Good to use as the Priority
+// Queue for Prim's and Dijkstra's algorithms.
+template <class T>
+class IndexedHeap {
+	private:
+		std::vector<NodeID> heap;     // The IDs in heap order
+		std::vector<NodeID> position; // Where each ID is in the heap, -1 if it is not
+		std::vector<T> keys;          // The key of each ID
+		int arity;                    // The amount of children each entry has
+		
+		// SiftUp
+		// params:
+		//	in: This is the heap position we are sifting up from
+		// Moves the entry up until its parent is not bigger than it
+		void SiftUp(NodeID in) {
+			NodeID id = heap[in];
+			
+			// While the entry has a parent bigger than it
+			while (in > 0) {
+				NodeID parent = (in - 1) / arity;
+				
+				if (!(keys[heap[parent]] > keys[id])) {
+					break;
+				}
+				
+				// Move the parent down into the hole
+				heap[in] = heap[parent];
+				position[heap[in]] = in;
+				in = parent;
+			}
+			
+			// Drop the entry into the hole
+			heap[in] = id;
+			position[id] = in;
+			
+			return;
+		}
+		
+		// SiftDown
+		// params:
+		//	in: This is the heap position we are sifting down from
+		// Moves the entry down until none of its children are smaller than it
+		void SiftDown(NodeID in) {
+			NodeID id = heap[in], size = heap.size();
+			
+			// While the entry has children
+			while (in * arity + 1 < size) {
+				NodeID first = in * arity + 1,
+					last = (first + arity < size ? first + arity : size),
+					best = first;
+				
+				// Find the smallest child
+				for (NodeID child = first + 1; child < last; child++) {
+					if (keys[heap[best]] > keys[heap[child]]) {
+						best = child;
+					}
+				}
+				
+				// If the smallest child is not smaller than the entry we are done
+				if (!(keys[id] > keys[heap[best]])) {
+					break;
+				}
+				
+				// Move the child up into the hole
+				heap[in] = heap[best];
+				position[heap[in]] = in;
+				in = best;
+			}
+			
+			// Drop the entry into the hole
+			heap[in] = id;
+			position[id] = in;
+			
+			return;
+		}
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	capacity: This is the amount of IDs the heap can hold
+		//	arity: This is the amount of children each entry has, defaulted to 4
+		// Initializes an empty heap for the IDs 0 to capacity - 1
+		IndexedHeap(NodeID capacity = 0, int arity = 4) : arity(arity < 2 ? 2 : arity) {
+			Resize(capacity);
+			return;
+		}
+		
+		// Resize
+		// params:
+		//	capacity: This is the amount of IDs the heap can hold
+		// Empties the heap and makes room for the IDs 0 to capacity - 1
+		void Resize(NodeID capacity) {
+			heap.clear();
+			heap.reserve(capacity);
+			position.assign(capacity, -1);
+			keys.resize(capacity);
+			
+			return;
+		}
+		
+		// Push
+		// params:
+		//	id: This is the ID to add
+		//	key: This is the key of the ID
+		// Adds the ID to the heap, returns false if it is already there
+		bool Push(NodeID id, T key) {
+			bool pushed = false;
+			
+			// If the ID is not already in the heap
+			if (position[id] == -1) {
+				keys[id] = key;
+				heap.push_back(id);
+				
+				// Restructure the heap so it is correct
+				SiftUp(heap.size() - 1);
+				
+				pushed = true;
+			}
+			
+			return pushed;
+		}
+		
+		// DecreaseKey
+		// params:
+		//	id: This is the ID whose key is lowered
+		//	key: This is the new key of the ID
+		// Lowers the key of an ID already in the heap, returns false if the
+		// ID is not in the heap or the key is not smaller
+		bool DecreaseKey(NodeID id, T key) {
+			bool decreased = false;
+			
+			// If the ID is in the heap and the key is smaller
+			if (position[id] != -1 && keys[id] > key) {
+				keys[id] = key;
+				
+				// Restructure the heap so it is correct
+				SiftUp(position[id]);
+				
+				decreased = true;
+			}
+			
+			return decreased;
+		}
+		
+		// PushOrDecrease
+		// params:
+		//	id: This is the ID to add or lower
+		//	key: This is the key of the ID
+		// Adds the ID if it is not in the heap, otherwise lowers its key.
+		// Returns true if the heap changed.
+		bool PushOrDecrease(NodeID id, T key) {
+			return (position[id] == -1 ? Push(id, key) : DecreaseKey(id, key));
+		}
+		
+		// Pop
+		// Removes the ID with the smallest key from the heap and returns it,
+		// returns -1 if the heap is empty
+		NodeID Pop() {
+			NodeID root = -1;
+			
+			// If there is something in the heap
+			if (heap.size() != 0) {
+				root = heap[0];
+				position[root] = -1;
+				
+				// Bring the last entry to act as the root
+				heap[0] = heap.back();
+				heap.pop_back();
+				
+				// Restructure the heap so it is correct
+				if (heap.size() != 0) {
+					SiftDown(0);
+				}
+			}
+			
+			return root;
+		}
+		
+		// Front
+		// Returns the ID with the smallest key, -1 if the heap is empty
+		NodeID Front() const {
+			return (heap.size() != 0 ? heap[0] : -1);
+		}
+		
+		// GetKey
+		// params:
+		//	id: This is the ID whose key we want
+		// Returns the last key given to the ID
+		T GetKey(NodeID id) const {
+			return keys[id];
+		}
+		
+		// Contains
+		// params:
+		//	id: This is the ID we are looking for
+		// Returns true if the ID is in the heap, false otherwise
+		bool Contains(NodeID id) const {
+			return (position[id] != -1);
+		}
+		
+		// Size
+		// Returns the amount of IDs in the heap
+		NodeID Size() const {
+			return heap.size();
+		}
+		
+		// Empty
+		// Returns true if the heap is empty, false otherwise
+		bool Empty() const {
+			return (heap.size() == 0);
+		}
+		
+		// Clear
+		// Removes all IDs from the heap, only touching the IDs in it
+		void Clear() {
+			for (NodeID i = 0; i < heap.size(); i++) {
+				position[heap[i]] = -1;
+			}
+			
+			heap.clear();
+			
+			return;
+		}
+		
+		// Print
+		// Prints the heap in a linear fashion as id(key)
+		void Print() const {
+			// For every entry in the heap
+			for (NodeID i = 0; i < heap.size(); i++) {
+				// Print the entry
+				std::cout << heap[i] << "(" << keys[heap[i]] << ")";
+				
+				// If this is not the last entry
+				if (i < heap.size() - 1) {
+					// Print a seperator
+					std::cout << " - ";
+				}
+			}
+			
+			std::cout << std::endl;
+			
+			return;
+		}
+};
+
+#endif
\ No newline at end of file
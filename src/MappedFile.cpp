@@ -0,0 +1,81 @@
+#include <fcntl.h> // For open
+#include <unistd.h> // For close
+#include <sys/mman.h> // For mmap and munmap
+#include <sys/stat.h> // For fstat
+#include "MappedFile.h"
+
+// Default Constructor
+// Creates an object that has nothing mapped
+MappedFile::MappedFile() : data(NULL), size(0) {
+	return;
+}
+
+// Destructor
+// Releases the mapping if there is one
+MappedFile::~MappedFile() {
+	Close();
+	return;
+}
+
+// Open
+// params:
+//	path: This is the path of the file to map
+// Maps the file into memory, returns true if it was mapped
+bool MappedFile::Open(const std::string & path) {
+	bool opened = false;
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat info;
+	
+	// Drop anything we already have mapped
+	Close();
+	
+	// If the file could be opened and has something in it
+	if (fd >= 0 && fstat(fd, &info) == 0 && info.st_size > 0) {
+		void * mapping = mmap(NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		
+		// If the file was mapped
+		if (mapping != MAP_FAILED) {
+			data = (const char *)mapping;
+			size = info.st_size;
+			opened = true;
+		}
+	}
+	
+	// The mapping stays valid once the descriptor is closed
+	if (fd >= 0) {
+		close(fd);
+	}
+	
+	return opened;
+}
+
+// Close
+// Releases the mapping if there is one
+void MappedFile::Close() {
+	if (data != NULL) {
+		munmap((void *)data, size);
+	}
+	
+	data = NULL;
+	size = 0;
+	
+	return;
+}
+
+// IsOpen
+// Returns true if a file is mapped, false otherwise
+bool MappedFile::IsOpen() const {
+	return (data != NULL);
+}
+
+// GetData
+// Returns the start of the mapped file
+const char * MappedFile::GetData() const {
+	return data;
+}
+
+// GetSize
+// Returns the size of the mapped file in bytes
+std::size_t MappedFile::GetSize() const {
+	return size;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string> // For the string class
+#include <cstddef> // For the size_t type
+
+// MappedFile
+// This class maps a whole file read-only into memory. The pages are
+// shared with the page cache, so several processes mapping the same file
+// share one copy and nothing is read until it is touched. The mapping is
+// released when the object is destroyed.
+class MappedFile {
+	private:
+		const char * data; // This is the start of the mapping
+		std::size_t size;  // This is the size of the mapping in bytes
+		
+		// Copy Constructor
+		// Mappings are not copyable, share them through a pointer instead
+		MappedFile(const MappedFile & file);
+		
+		// operator= Overload
+		// Mappings are not copyable, share them through a pointer instead
+		MappedFile & operator=(const MappedFile & file);
+	
+	public:
+		// Default Constructor
+		// Creates an object that has nothing mapped
+		MappedFile();
+		
+		// Destructor
+		// Releases the mapping if there is one
+		~MappedFile();
+		
+		// Open
+		// params:
+		//	path: This is the path of the file to map
+		// Maps the file into memory, returns true if it was mapped
+		bool Open(const std::string & path);
+		
+		// Close
+		// Releases the mapping if there is one
+		void Close();
+		
+		// IsOpen
+		// Returns true if a file is mapped, false otherwise
+		bool IsOpen() const;
+		
+		// GetData
+		// Returns the start of the mapped file
+		const char * GetData() const;
+		
+		// GetSize
+		// Returns the size of the mapped file in bytes
+		std::size_t GetSize() const;
+}; // End MappedFile Class
+
+#endif
\ No newline at end of file
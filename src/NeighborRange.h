@@ -0,0 +1,158 @@
+#ifndef NEIGHBOR_RANGE_H
+#define NEIGHBOR_RANGE_H
+
+#include <cstddef> // For NULL and ptrdiff_t
+#include <iterator> // For the forward_iterator_tag struct
+#include "Edge.h" // For the Edge class
+
+// NeighborRange
+// This is a non-owning view over the edges leaving a node. It lets
+// callers walk a nodes neighbors without copying its edge list. Nodes
+// only store the end node and weight of each edge, so the range hands
+// out the end IDs and weights directly and builds an Edge only when one
+// is asked for. The range is only valid until the node it came from is
+// next modified.
+class NeighborRange {
+	private:
+		NodeID start;           // The node the edges leave
+		const NodeID * targets; // The end node of every edge
+		const Weight * weights; // The weight of every edge, NULL when unweighted
+		int size;               // The amount of edges in the range
+	
+	public:
+		// const_iterator
+		// Walks the range in order, every step gives a whole Edge. The edge
+		// is built inside the iterator, so a reference to it is only good
+		// until the iterator moves.
+		class const_iterator {
+			private:
+				const NeighborRange * range;
+				int index;
+				mutable Edge current; // The edge last built for the current position
+			
+			public:
+				typedef std::forward_iterator_tag iterator_category;
+				typedef Edge value_type;
+				typedef std::ptrdiff_t difference_type;
+				typedef const Edge * pointer;
+				typedef const Edge & reference;
+				
+				// Parameterized Constructor
+				// params:
+				//	range: This is the range being walked
+				//	index: This is the position in the range
+				const_iterator(const NeighborRange * range = NULL, int index = 0) : range(range), index(index), current(-1, -1) {
+					return;
+				}
+				
+				// operator* Overload
+				// Returns the edge at the current position
+				const Edge & operator*() const {
+					current = (*range)[index];
+					return current;
+				}
+				
+				// operator-> Overload
+				// Returns a pointer to the edge at the current position
+				const Edge * operator->() const {
+					return &**this;
+				}
+				
+				// operator++ Overload
+				// Moves to the next edge
+				const_iterator & operator++() {
+					++index;
+					return *this;
+				}
+				
+				// operator++ Overload
+				// Moves to the next edge, returning where it was
+				const_iterator operator++(int) {
+					const_iterator before = *this;
+					++index;
+					return before;
+				}
+				
+				// operator== Overload
+				// params:
+				//	it: This is the iterator we are comparing against
+				// Returns true if both are at the same position
+				bool operator==(const const_iterator & it) const {
+					return (index == it.index);
+				}
+				
+				// operator!= Overload
+				// params:
+				//	it: This is the iterator we are comparing against
+				// Returns true if they are at different positions
+				bool operator!=(const const_iterator & it) const {
+					return (index != it.index);
+				}
+		};
+		
+		// Default Constructor
+		// Creates an empty range
+		NeighborRange() : start(-1), targets(NULL), weights(NULL), size(0) {
+			return;
+		}
+		
+		// Parameterized Constructor
+		// params:
+		//	start: This is the node the edges leave
+		//	targets: This is the end node of every edge
+		//	weights: This is the weight of every edge, NULL when unweighted
+		//	size: This is the amount of edges
+		NeighborRange(NodeID start, const NodeID * targets, const Weight * weights, int size) : start(start), targets(targets), weights(weights), size(size) {
+			return;
+		}
+		
+		// begin
+		// Returns an iterator to the first edge in the range
+		const_iterator begin() const {
+			return const_iterator(this, 0);
+		}
+		
+		// end
+		// Returns an iterator one past the last edge in the range
+		const_iterator end() const {
+			return const_iterator(this, size);
+		}
+		
+		// Size
+		// Returns the amount of edges in the range
+		int Size() const {
+			return size;
+		}
+		
+		// Empty
+		// Returns true if the range has no edges, false otherwise
+		bool Empty() const {
+			return (size == 0);
+		}
+		
+		// GetTarget
+		// params:
+		//	index: This is the index of the edge we want
+		// Returns the end node ID of the edge at the index
+		NodeID GetTarget(int index) const {
+			return targets[index];
+		}
+		
+		// GetWeight
+		// params:
+		//	index: This is the index of the edge we want
+		// Returns the weight of the edge at the index
+		Weight GetWeight(int index) const {
+			return (weights != NULL ? weights[index] : 1);
+		}
+		
+		// operator[] Overload
+		// params:
+		//	index: This is the index of the edge we want
+		// Returns the edge at the index
+		Edge operator[](int index) const {
+			return Edge(start, targets[index], GetWeight(index));
+		}
+}; // End NeighborRange Class
+
+#endif
\ No newline at end of file
@@ -3,16 +3,22 @@
 
 // Default Constructor
 // Initializes the node to default values
-Node::Node() : id(0) {
-	edges.clear();
+Node::Node() : id(0), indexed(false) {
 	return;
 }
 
 // Parameterized constructor
 // params:
 //	id: This is the id associated with the node
-Node::Node(NodeID id) : id(id) {
-	edges.clear();
+Node::Node(NodeID id) : id(id), indexed(false) {
+	return;
+}
+
+// Parameterized constructor
+// params:
+//	id: This is the id associated with the node
+//	arena: This is the arena the edge arrays are allocated from
+Node::Node(NodeID id, EdgeArena * arena) : id(id), targets(ArenaAllocator<NodeID>(arena)), weights(ArenaAllocator<Weight>(arena)), indexed(false) {
 	return;
 }
 
@@ -23,24 +29,98 @@ NodeID Node::GetID() const {
 }
 
 // GetEdges
-// Returns the edges for this node
+// Returns a copy of the edges for this node
 EdgeList Node::GetEdges() const {
+	EdgeList edges;
+	
+	// Put the start of every edge back
+	edges.reserve(targets.size());
+	for (int i = 0; i < targets.size(); i++) {
+		edges.push_back(Edge(id, targets[i], GetWeight(i)));
+	}
+	
 	return edges;
 }
 
+// GetNeighbors
+// Returns a view over the edges for this node without copying them
+NeighborRange Node::GetNeighbors() const {
+	return NeighborRange(id, targets.data(), (WeightedEdges ? weights.data() : NULL), targets.size());
+}
+
+// GetDegree
+// Returns the amount of edges leaving this node
+int Node::GetDegree() const {
+	return targets.size();
+}
+
+// GetTarget
+// params:
+//	index: This is the position of the edge in the list
+// Returns the end node ID of the edge
+NodeID Node::GetTarget(int index) const {
+	return targets[index];
+}
+
+// GetWeight
+// params:
+//	index: This is the position of the edge in the list
+// Returns the weight of the edge, always 1 when unweighted
+Weight Node::GetWeight(int index) const {
+	return (WeightedEdges ? weights[index] : 1);
+}
+
+// AppendEdge
+// params:
+//	endID: This is the id associated with end of the link
+//	weight: This is the weight associated with this link
+// Adds the edge to the end of the list without checking for a
+// duplicate, for callers that already know it is not there
+void Node::AppendEdge(NodeID endID, Weight weight) {
+	targets.push_back(endID);
+	
+	if (WeightedEdges) {
+		weights.push_back(weight);
+	}
+	
+	return;
+}
+
+// ReserveEdges
+// params:
+//	count: This is the amount of edges the node will have
+// Sizes the edge arrays up front so appending does not reallocate
+void Node::ReserveEdges(int count) {
+	targets.reserve(count);
+	
+	if (WeightedEdges) {
+		weights.reserve(count);
+	}
+	
+	return;
+}
+
 // AddEdge
 // params:
 //	endID: This is the id associated with end of the link
 //	weight: This is the weight associated with this link
 // Adds the edge to the list of edges for this node
-bool Node::AddEdge(NodeID endID, float weight) {
+bool Node::AddEdge(NodeID endID, Weight weight) {
 	bool added = false;
 	
 	// If we don't already contain this edge
 	// and the end node isn't this node
 	if (!ContainsEdge(endID) && (endID != id)) {
 		// Add the edge to our list of edges
-		edges.push_back(Edge(id, endID, weight));
+		AppendEdge(endID, weight);
+		
+		// If we are indexed record where the edge went,
+		// otherwise start indexing once we grow too large
+		if (indexed) {
+			edgeIndex[endID] = targets.size() - 1;
+		} else if (targets.size() > IndexThreshold) {
+			BuildIndex();
+		}
 		
 		// We added the edge
 		added = true;
@@ -55,12 +135,37 @@ bool Node::AddEdge(NodeID endID, float weight) {
 // Removes the associated edge from this node
 bool Node::RemoveEdge(NodeID endID) {
 	bool removed = false;
+	int endIndex = GetEdgeIndex(endID);
 	
 	// If this edge exists
 	// and the end node isn't this node
-	if (ContainsEdge(endID) && (endID != id)) {
-		// Remove this edge from our list of edges
-		edges.erase(edges.begin() + GetEdgeIndex(endID));
+	if (endIndex != -1) {
+		// If we are indexed
+		if (indexed) {
+			// Move the last edge into the removed edges slot so
+			// nothing has to shift, and keep the index up to date
+			targets[endIndex] = targets.back();
+			edgeIndex[targets[endIndex]] = endIndex;
+			edgeIndex.erase(endID);
+			targets.pop_back();
+			
+			if (WeightedEdges) {
+				weights[endIndex] = weights.back();
+				weights.pop_back();
+			}
+			
+			// If we have shrunk well below the threshold stop indexing
+			if (targets.size() <= IndexThreshold / 2) {
+				DropIndex();
+			}
+		} else {
+			// Remove this edge from our list of edges
+			targets.erase(targets.begin() + endIndex);
+			
+			if (WeightedEdges) {
+				weights.erase(weights.begin() + endIndex);
+			}
+		}
 		
 		// We removed the edge
 		removed = true;
@@ -76,21 +181,30 @@ bool Node::RemoveEdge(NodeID endID) {
 //	keepWeight: Is a flag to tell if a new weight should be assigned
 //	newWeight: This is the new weight to be associated with the link, defaulted to 0
 // This function updates an edges values
-bool Node::UpdateEdge(NodeID endID, float newEndID, bool keepWeight, float newWeight) {
+bool Node::UpdateEdge(NodeID endID, NodeID newEndID, bool keepWeight, Weight newWeight) {
 	bool updated = false;
+	int endIndex = GetEdgeIndex(endID);
 	
 	// If this edge exists
 	// and the end node isn't this node
-	if (ContainsEdge(endID) && (newEndID != id)) {
-		int endIndex = GetEdgeIndex(endID);
+	if ((endIndex != -1) && (newEndID != id)) {
+		Weight weight = (keepWeight ? GetWeight(endIndex) : newWeight);
 		
-		// Add the edge to the list with the new information
-		AddEdge(newEndID, (keepWeight ? edges[endIndex].GetWeight() : newWeight));
-		
-		// Remove this edge from our list of edges
-		edges.erase(edges.begin() + endIndex);
+		// If only the weight is changing
+		if (newEndID == endID) {
+			// Replace the weight in place
+			if (WeightedEdges) {
+				weights[endIndex] = weight;
+			}
+		} else {
+			// Remove this edge from our list of edges
+			RemoveEdge(endID);
+			
+			// Add the edge to the list with the new information
+			AddEdge(newEndID, weight);
+		}
 		
-		// We removed the edge
+		// We updated the edge
 		updated = true;
 	}
 	
@@ -114,12 +228,22 @@ int Node::GetEdgeIndex(NodeID node) const {
 	
 	// If the node we are looking for is not this node
 	if (node != id) {
-		// For every edge while we havent found the edge
-		for (int i = 0; (i < edges.size()) && (index == -1); i++) {
-			// If this is the edge we are looking for
-			if (edges[i].GetID() == node) {
-				// Get the index
-				index = i;
+		// If we are indexed
+		if (indexed) {
+			// Look the edge up directly
+			std::unordered_map<NodeID, int>::const_iterator it = edgeIndex.find(node);
+			
+			if (it != edgeIndex.end()) {
+				index = it->second;
+			}
+		} else {
+			// For every edge while we havent found the edge
+			for (int i = 0; (i < targets.size()) && (index == -1); i++) {
+				// If this is the edge we are looking for
+				if (targets[i] == node) {
+					// Get the index
+					index = i;
+				}
 			}
 		}
 	}
@@ -127,6 +251,32 @@ int Node::GetEdgeIndex(NodeID node) const {
 	return index;
 }
 
+// BuildIndex
+// Builds the neighbor index from the current list of edges
+void Node::BuildIndex() {
+	edgeIndex.clear();
+	edgeIndex.reserve(targets.size() * 2);
+	
+	// For every edge
+	for (int i = 0; i < targets.size(); i++) {
+		// Record its position
+		edgeIndex[targets[i]] = i;
+	}
+	
+	indexed = true;
+	
+	return;
+}
+
+// DropIndex
+// Releases the neighbor index and returns to linear scans
+void Node::DropIndex() {
+	std::unordered_map<NodeID, int>().swap(edgeIndex);
+	indexed = false;
+	
+	return;
+}
+
 // Print
 // Prints the contents of the node
 void Node::Print() const {
@@ -134,10 +284,10 @@ void Node::Print() const {
 	std::cout << id;
 	
 	// For every edge
-	for (int i = 0; i < edges.size(); i++) {
+	for (int i = 0; i < targets.size(); i++) {
 		// Print the edges information
 		std::cout << " - ";
-		edges[i].Print();
+		Edge(id, targets[i], GetWeight(i)).Print();
 	}
 	
 	return;
@@ -2,22 +2,63 @@
 #define NODE_H
 
 #include <vector> // For the vector class to store Edges
+#include <unordered_map> // For the neighbor index of high degree nodes
 #include "Edge.h" // For the Edge class
+#include "NeighborRange.h" // For the NeighborRange class
+#include "EdgeArena.h" // For the ArenaAllocator class
 
 typedef std::vector<Edge> EdgeList;
 
 // Node
 // This is a class that represents a node in a graph. It houses a list for
-// its edges.
+// its edges. The start of every edge is the node itself, so only the end
+// node and weight of each edge are stored, in two parallel arrays, and
+// scanning the neighbors only reads the IDs. Nodes made by a Graph keep
+// their arrays in the graphs EdgeArena, others use the heap.
 class Node {
 	private:
 		// instance variables
 		NodeID id;
-		EdgeList edges;
+		std::vector<NodeID, ArenaAllocator<NodeID> > targets; // The end node of every edge
+		std::vector<Weight, ArenaAllocator<Weight> > weights; // The weight of every edge, empty when unweighted
+		std::unordered_map<NodeID, int> edgeIndex; // Maps a neighbor to its position in targets
+		bool indexed; // Is a flag if edgeIndex is being maintained
 		
 		// Default constructor
 		Node();
 		
+		// Parameterized constructor
+		// params:
+		//	id: This is the id associated with the node
+		//	arena: This is the arena the edge arrays are allocated from
+		Node(NodeID id, EdgeArena * arena);
+		
+		// AppendEdge
+		// params:
+		//	endID: This is the id associated with end of the link
+		//	weight: This is the weight associated with this link
+		// Adds the edge to the end of the list without checking for a
+		// duplicate, for callers that already know it is not there
+		void AppendEdge(NodeID endID, Weight weight);
+		
+		// ReserveEdges
+		// params:
+		//	count: This is the amount of edges the node will have
+		// Sizes the edge arrays up front so appending does not reallocate
+		void ReserveEdges(int count);
+		
+		// BuildIndex
+		// Builds the neighbor index from the current list of edges
+		void BuildIndex();
+		
+		// DropIndex
+		// Releases the neighbor index and returns to linear scans
+		void DropIndex();
+		
+		friend class GraphBuilder;
+		friend class Graph;
+		friend struct SpanningForest;
+		
 		// GetEdgeIndex
 		// params:
 		//	node: This is the node we are looking for
@@ -25,6 +66,12 @@ class Node {
 		int GetEdgeIndex(NodeID node) const;
 		
 	public:
+		// IndexThreshold
+		// Once a node has more edges than this, duplicate checks, lookups
+		// and removals go through a hashed neighbor index instead of a
+		// linear scan. Nodes at or below it keep only the compact vector.
+		static const int IndexThreshold = 32;
+		
 		// Parameterized constructor
 		// params:
 		//	id: This is the id associated with the node
@@ -35,15 +82,35 @@ class Node {
 		NodeID GetID() const;
 		
 		// GetEdges
-		// Returns the edges for this node
+		// Returns a copy of the edges for this node
 		EdgeList GetEdges() const;
 		
+		// GetNeighbors
+		// Returns a view over the edges for this node without copying them
+		NeighborRange GetNeighbors() const;
+		
+		// GetDegree
+		// Returns the amount of edges leaving this node
+		int GetDegree() const;
+		
+		// GetTarget
+		// params:
+		//	index: This is the position of the edge in the list
+		// Returns the end node ID of the edge
+		NodeID GetTarget(int index) const;
+		
+		// GetWeight
+		// params:
+		//	index: This is the position of the edge in the list
+		// Returns the weight of the edge, always 1 when unweighted
+		Weight GetWeight(int index) const;
+		
 		// AddEdge
 		// params:
 		//	endID: This is the id associated with end of the link
 		//	weight: This is the weight associated with this link
 		// Adds the edge to the list of edges for this node
-		bool AddEdge(NodeID endID, float weight);
+		bool AddEdge(NodeID endID, Weight weight);
 		
 		// RemoveEdge
 		// params:
@@ -58,7 +125,7 @@ class Node {
 		//	keepWeight: Is a flag to tell if a new weight should be assigned
 		//	newWeight: This is the new weight to be associated with the link, defaulted to 0
 		// This function updates an edges values
-		bool UpdateEdge(NodeID endID, float newEndID, bool keepWeight, float newWeight = 0);
+		bool UpdateEdge(NodeID endID, NodeID newEndID, bool keepWeight, Weight newWeight = 0);
 		
 		// ContainsEdge
 		// params:
@@ -71,4 +138,6 @@ class Node {
 		void Print() const;
 }; // End Node Class
 
+typedef std::vector<Node> AdjList;
+
 #endif
\ No newline at end of file
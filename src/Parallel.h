@@ -0,0 +1,253 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <vector> // For the vector class
+#include <thread> // For the thread class
+#include <mutex> // For the mutex class
+#include <condition_variable> // For the condition_variable class
+#include <stdint.h> // For the fixed width integer types
+
+// GetNumThreads
+// Returns the number of threads the parallel routines will use
+inline int GetNumThreads() {
+	int threads = std::thread::hardware_concurrency();
+	
+	// If the hardware could not be queried fall back to one thread
+	if (threads < 1) {
+		threads = 1;
+	}
+	
+	return threads;
+}
+
+// ParallelFor
+// params:
+//	begin: This is the first index of the range
+//	end: This is one past the last index of the range
+//	function: This is called as function(thread, first, last) for each chunk
+//	threads: This is the amount of threads to use, 0 uses every core
+// Splits [begin, end) into one contiguous chunk per thread and runs the
+// function on every chunk in parallel. Small ranges run on the caller.
+template <class Function>
+void ParallelFor(uint64_t begin, uint64_t end, Function function, int threads = 0) {
+	const uint64_t minChunk = 4096;
+	uint64_t count = (end > begin ? end - begin : 0);
+	
+	// Work out how many threads are worth starting
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	if (count / minChunk < (uint64_t)threads) {
+		threads = (int)(count / minChunk);
+	}
+	
+	// If the range is too small to split run it here
+	if (threads <= 1) {
+		if (count > 0) {
+			function(0, begin, end);
+		}
+		
+		return;
+	}
+	
+	std::vector<std::thread> workers;
+	uint64_t chunk = (count + threads - 1) / threads;
+	
+	// For every thread after the first
+	for (int i = 1; i < threads; i++) {
+		uint64_t first = begin + chunk * i,
+				 last = (first + chunk < end ? first + chunk : end);
+		
+		// Hand it its chunk
+		if (first < last) {
+			workers.push_back(std::thread(function, i, first, last));
+		}
+	}
+	
+	// The calling thread handles the first chunk
+	function(0, begin, (begin + chunk < end ? begin + chunk : end));
+	
+	// Wait for the rest of the chunks
+	for (int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+	
+	return;
+}
+
+// ParallelThreads
+// params:
+//	function: This is called as function(thread, threads) on every thread
+//	threads: This is the amount of threads to use, 0 uses every core
+// Runs the function once on each of the threads, the calling thread
+// takes part as thread 0. Used when the threads split the work themselves.
+template <class Function>
+void ParallelThreads(Function function, int threads = 0) {
+	std::vector<std::thread> workers;
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// Start every thread after the first
+	for (int i = 1; i < threads; i++) {
+		workers.push_back(std::thread(function, i, threads));
+	}
+	
+	// The calling thread is thread 0
+	function(0, threads);
+	
+	// Wait for the rest of the threads
+	for (int i = 0; i < workers.size(); i++) {
+		workers[i].join();
+	}
+	
+	return;
+}
+
+// ThreadBarrier
+// This blocks every thread that calls Wait until the set amount of threads
+// have all called it, then lets them all through together. It can be used
+// again straight away, so the threads of a ParallelThreads call can step
+// through phases of an algorithm in lockstep.
+class ThreadBarrier {
+	private:
+		std::mutex lock;
+		std::condition_variable released;
+		int threads;     // The amount of threads that wait at the barrier
+		int waiting;     // The amount of threads waiting right now
+		int generation;  // Counts how many times the barrier has let the threads through
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	threads: This is the amount of threads that wait at the barrier
+		ThreadBarrier(int threads) : threads(threads), waiting(0), generation(0) {
+			return;
+		}
+		
+		// Wait
+		// Blocks until every thread has reached the barrier
+		void Wait() {
+			std::unique_lock<std::mutex> guard(lock);
+			int arrived = generation;
+			
+			// If this is the last thread let everyone through
+			if (++waiting == threads) {
+				waiting = 0;
+				generation++;
+				released.notify_all();
+			} else {
+				while (arrived == generation) {
+					released.wait(guard);
+				}
+			}
+			
+			return;
+		}
+};
+
+// ParallelSplit
+// params:
+//	items: This is the list holding the range
+//	buffer: This is scratch space at least as big as items
+//	first: This is the first index of the range
+//	last: This is one past the last index of the range
+//	left: This is called as left(item) and returns true for items that go first
+//	keepRight: Is a flag if the items that do not go first are kept after them
+//	threads: This is the amount of threads to use, 0 uses every core
+// Stably moves the items of [first, last) that go first to the front of the
+// range, followed by the rest if they are kept. Every thread counts its chunk,
+// the counts give each chunk where to write, then every chunk is scattered
+// into the buffer and copied back. Returns the index one past the items that
+// went first. Used by ParallelPartition and ParallelFilter.
+template <class T, class Predicate>
+uint64_t ParallelSplit(std::vector<T> & items, std::vector<T> & buffer, uint64_t first, uint64_t last, Predicate left, bool keepRight, int threads) {
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	std::vector<uint64_t> lefts(threads, 0), sizes(threads, 0);
+	
+	// Count the items each chunk sends first
+	ParallelFor(first, last, [&](int thread, uint64_t begin, uint64_t end) {
+		for (uint64_t i = begin; i < end; i++) {
+			lefts[thread] += (left(items[i]) ? 1 : 0);
+		}
+		
+		sizes[thread] = end - begin;
+	}, threads);
+	
+	// Turn the counts into where each chunk writes
+	std::vector<uint64_t> leftAt(threads), rightAt(threads);
+	uint64_t nextLeft = first, nextRight = first;
+	
+	for (int i = 0; i < threads; i++) {
+		nextRight += lefts[i];
+	}
+	
+	uint64_t middle = nextRight;
+	
+	for (int i = 0; i < threads; i++) {
+		leftAt[i] = nextLeft;
+		rightAt[i] = nextRight;
+		nextLeft += lefts[i];
+		nextRight += sizes[i] - lefts[i];
+	}
+	
+	// Scatter every chunk into the buffer, the chunks line up with the counting pass
+	ParallelFor(first, last, [&](int thread, uint64_t begin, uint64_t end) {
+		uint64_t l = leftAt[thread], r = rightAt[thread];
+		
+		for (uint64_t i = begin; i < end; i++) {
+			if (left(items[i])) {
+				buffer[l++] = items[i];
+			} else if (keepRight) {
+				buffer[r++] = items[i];
+			}
+		}
+	}, threads);
+	
+	// Copy the kept items back into the range
+	uint64_t kept = (keepRight ? last : middle);
+	ParallelFor(first, kept, [&](int thread, uint64_t begin, uint64_t end) {
+		for (uint64_t i = begin; i < end; i++) {
+			items[i] = buffer[i];
+		}
+	}, threads);
+	
+	return middle;
+}
+
+// ParallelPartition
+// params:
+//	items: This is the list holding the range
+//	buffer: This is scratch space at least as big as items
+//	first: This is the first index of the range
+//	last: This is one past the last index of the range
+//	left: This is called as left(item) and returns true for items that go first
+//	threads: This is the amount of threads to use, 0 uses every core
+// Stably partitions [first, last) so the items that go first come before
+// the rest. Returns the index of the first item that did not go first.
+template <class T, class Predicate>
+uint64_t ParallelPartition(std::vector<T> & items, std::vector<T> & buffer, uint64_t first, uint64_t last, Predicate left, int threads = 0) {
+	return ParallelSplit(items, buffer, first, last, left, true, threads);
+}
+
+// ParallelFilter
+// params:
+//	items: This is the list holding the range
+//	buffer: This is scratch space at least as big as items
+//	first: This is the first index of the range
+//	last: This is one past the last index of the range
+//	keep: This is called as keep(item) and returns true for items to keep
+//	threads: This is the amount of threads to use, 0 uses every core
+// Stably packs the kept items of [first, last) at the front of the range.
+// Returns the index one past the last kept item.
+template <class T, class Predicate>
+uint64_t ParallelFilter(std::vector<T> & items, std::vector<T> & buffer, uint64_t first, uint64_t last, Predicate keep, int threads = 0) {
+	return ParallelSplit(items, buffer, first, last, keep, false, threads);
+}
+
+#endif
\ No newline at end of file
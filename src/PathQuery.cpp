@@ -0,0 +1,169 @@
+#include <algorithm> // For the reverse function
+#include "PathQuery.h"
+
+// Parameterized Constructor
+// params:
+//	graph: This is the graph to search, it must outlive the query
+//	incoming: This is the Transpose of the graph, it can be left NULL
+//	          when the graph is undirected
+PathQuery::PathQuery(const CsrGraph & graph, const CsrGraph * incoming) : graph(&graph), incoming(incoming) {
+	Side * sides[2] = { &forward, &backward };
+	
+	if (this->incoming == NULL) {
+		this->incoming = &graph;
+	}
+	
+	// Size both workspaces for every node once
+	for (int i = 0; i < 2; i++) {
+		sides[i]->heap.Resize(graph.GetNumVertices());
+		sides[i]->distances.assign(graph.GetNumVertices(), InfiniteWeight);
+		sides[i]->parents.assign(graph.GetNumVertices(), -1);
+	}
+	
+	return;
+}
+
+// Reset
+// params:
+//	side: This is the workspace to reset
+// Puts every node the last search touched back to unreached
+void PathQuery::Reset(Side & side) {
+	for (NodeID i = 0; i < side.touched.size(); i++) {
+		side.distances[side.touched[i]] = InfiniteWeight;
+		side.parents[side.touched[i]] = -1;
+	}
+	
+	side.touched.clear();
+	side.heap.Clear();
+	
+	return;
+}
+
+// Reach
+// params:
+//	side: This is the workspace to update
+//	node: This is the node reached
+//	distance: This is the distance to the node
+//	parent: This is the node before it on the path
+// Records a new shortest distance to the node
+void PathQuery::Reach(Side & side, NodeID node, Weight distance, NodeID parent) {
+	// Remember the node so the next search can reset it
+	if (side.distances[node] == InfiniteWeight) {
+		side.touched.push_back(node);
+	}
+	
+	side.distances[node] = distance;
+	side.parents[node] = parent;
+	
+	return;
+}
+
+// Settle
+// params:
+//	side: This is the workspace to settle a node from
+//	other: This is the workspace of the search going the other way
+//	from: This is the graph whose edges this side follows
+//	best: This is the length of the shortest path found so far
+//	meet: This is the node the shortest path found so far goes through
+// Settles the closest node of the side and relaxes its edges, checking
+// every neighbor the other side has reached for a shorter path
+void PathQuery::Settle(Side & side, Side & other, const CsrGraph * from, Weight & best, NodeID & meet) {
+	NodeID node = side.heap.Pop();
+	Weight distance = side.distances[node];
+	
+	// For every neighbor to this node
+	for (EdgeIndex j = from->offsets[node]; j < from->offsets[node + 1]; j++) {
+		NodeID neighbor = from->targets[j];
+		Weight through = distance + from->GetWeight(j);
+		
+		// If going through this node is a shorter way to the neighbor
+		if (through < side.distances[neighbor]) {
+			Reach(side, neighbor, through, node);
+			side.heap.PushOrDecrease(neighbor, through);
+		}
+		
+		// If the other side reached the neighbor this joins a full path, an
+		// unreached neighbor is skipped so integer weights can not overflow
+		if (other.distances[neighbor] != InfiniteWeight && through + other.distances[neighbor] < best) {
+			best = through + other.distances[neighbor];
+			meet = neighbor;
+		}
+	}
+	
+	return;
+}
+
+// TracePath
+// params:
+//	meet: This is the node the path goes through
+//	path: This is filled with the nodes on the path
+// Follows the forward parents back to the source and the backward
+// parents on to the target
+void PathQuery::TracePath(NodeID meet, std::vector<NodeID> & path) const {
+	// Walk back from the meeting node to the source
+	for (NodeID node = meet; node != -1; node = forward.parents[node]) {
+		path.push_back(node);
+	}
+	
+	std::reverse(path.begin(), path.end());
+	
+	// Walk on from the meeting node to the target
+	for (NodeID node = backward.parents[meet]; node != -1; node = backward.parents[node]) {
+		path.push_back(node);
+	}
+	
+	return;
+}
+
+// ShortestPath
+// params:
+//	source: This is the node the path starts at
+//	target: This is the node the path ends at
+//	path: This is filled with the nodes on the path if it is not NULL
+// Runs a bidirectional Dijkstra from the source and back from the target
+// until the two searches can not find anything shorter. Returns the
+// length of the shortest path, infinite if there is none. The weights
+// must not be negative.
+Weight PathQuery::ShortestPath(NodeID source, NodeID target, std::vector<NodeID> * path) {
+	Weight best = InfiniteWeight;
+	NodeID meet = -1;
+	
+	Reset(forward);
+	Reset(backward);
+	
+	if (path != NULL) {
+		path->clear();
+	}
+	
+	// If either end is not in the graph there is no path
+	if (!graph->Contains(source) || !graph->Contains(target)) {
+		return best;
+	}
+	
+	Reach(forward, source, 0, -1);
+	forward.heap.Push(source, 0);
+	Reach(backward, target, 0, -1);
+	backward.heap.Push(target, 0);
+	
+	if (source == target) {
+		best = 0;
+		meet = source;
+	}
+	
+	// While both sides have nodes left and could still find a shorter path
+	while (!forward.heap.Empty() && !backward.heap.Empty() &&
+		   forward.heap.GetKey(forward.heap.Front()) + backward.heap.GetKey(backward.heap.Front()) < best) {
+		// Grow the side with the closer frontier
+		if (forward.heap.GetKey(forward.heap.Front()) <= backward.heap.GetKey(backward.heap.Front())) {
+			Settle(forward, backward, graph, best, meet);
+		} else {
+			Settle(backward, forward, incoming, best, meet);
+		}
+	}
+	
+	if (path != NULL && meet != -1) {
+		TracePath(meet, *path);
+	}
+	
+	return best;
+}
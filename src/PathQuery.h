@@ -0,0 +1,150 @@
+#ifndef PATH_QUERY_H
+#define PATH_QUERY_H
+
+#include <vector> // For the vector class
+#include <algorithm> // For the reverse function
+#include "CsrGraph.h" // For the CsrGraph class
+#include "IndexedHeap.h" // For the IndexedHeap class
+
+// PathQuery
+// This answers point to point shortest path queries on a CsrGraph. All of
+// the heaps, distances and parents a search needs are allocated once when
+// the query is made, and each search only resets the nodes the last one
+// touched, so a query costs nothing for the parts of the graph it never
+// reaches. Keep one PathQuery per thread and reuse it for every query.
+class PathQuery {
+	private:
+		// Side
+		// The workspace for searching in one direction
+		struct Side {
+			IndexedHeap<Weight> heap;      // The nodes waiting to be settled
+			std::vector<Weight> distances; // The distance to every node, infinite if unreached
+			std::vector<NodeID> parents;   // The node before every node on its path
+			std::vector<NodeID> touched;   // Every node given a distance by the last search
+		};
+		
+		const CsrGraph * graph;    // The graph being searched
+		const CsrGraph * incoming; // The Transpose of the graph, used to search backwards
+		Side forward, backward;
+		
+		// Reset
+		// params:
+		//	side: This is the workspace to reset
+		// Puts every node the last search touched back to unreached
+		static void Reset(Side & side);
+		
+		// Reach
+		// params:
+		//	side: This is the workspace to update
+		//	node: This is the node reached
+		//	distance: This is the distance to the node
+		//	parent: This is the node before it on the path
+		// Records a new shortest distance to the node
+		static void Reach(Side & side, NodeID node, Weight distance, NodeID parent);
+		
+		// Settle
+		// params:
+		//	side: This is the workspace to settle a node from
+		//	other: This is the workspace of the search going the other way
+		//	from: This is the graph whose edges this side follows
+		//	best: This is the length of the shortest path found so far
+		//	meet: This is the node the shortest path found so far goes through
+		// Settles the closest node of the side and relaxes its edges, checking
+		// every neighbor the other side has reached for a shorter path
+		static void Settle(Side & side, Side & other, const CsrGraph * from, Weight & best, NodeID & meet);
+		
+		// TracePath
+		// params:
+		//	meet: This is the node the path goes through
+		//	path: This is filled with the nodes on the path
+		// Follows the forward parents back to the source and the backward
+		// parents on to the target
+		void TracePath(NodeID meet, std::vector<NodeID> & path) const;
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	graph: This is the graph to search, it must outlive the query
+		//	incoming: This is the Transpose of the graph, it can be left NULL
+		//	          when the graph is undirected
+		PathQuery(const CsrGraph & graph, const CsrGraph * incoming = NULL);
+		
+		// ShortestPath
+		// params:
+		//	source: This is the node the path starts at
+		//	target: This is the node the path ends at
+		//	path: This is filled with the nodes on the path if it is not NULL
+		// Runs a bidirectional Dijkstra from the source and back from the target
+		// until the two searches can not find anything shorter. Returns the
+		// length of the shortest path, infinite if there is none. The weights
+		// must not be negative.
+		Weight ShortestPath(NodeID source, NodeID target, std::vector<NodeID> * path = NULL);
+		
+		// AStar
+		// params:
+		//	source: This is the node the path starts at
+		//	target: This is the node the path ends at
+		//	heuristic: This is called as heuristic(node) and returns a lower
+		//	           bound on the distance from the node to the target
+		//	path: This is filled with the nodes on the path if it is not NULL
+		// Runs an A* search from the source to the target, settling nodes in
+		// order of their distance plus the heuristic. The heuristic is a template
+		// parameter so it is inlined into the search. As long as it never
+		// overestimates the result is exact, and if it also never drops by more
+		// than an edge weight along an edge every node is only settled once.
+		// Returns the length of the shortest path, infinite if there is none.
+		template <class Heuristic>
+		Weight AStar(NodeID source, NodeID target, Heuristic heuristic, std::vector<NodeID> * path = NULL) {
+			Weight best = InfiniteWeight;
+			NodeID node;
+			
+			Reset(forward);
+			
+			if (path != NULL) {
+				path->clear();
+			}
+			
+			// If either end is not in the graph there is no path
+			if (!graph->Contains(source) || !graph->Contains(target)) {
+				return best;
+			}
+			
+			Reach(forward, source, 0, -1);
+			forward.heap.Push(source, heuristic(source));
+			
+			// While there are nodes left to settle, most promising first
+			while ((node = forward.heap.Pop()) != -1) {
+				Weight distance = forward.distances[node];
+				
+				// If this is the target its distance is final
+				if (node == target) {
+					best = distance;
+					break;
+				}
+				
+				// For every neighbor to this node
+				for (EdgeIndex j = graph->offsets[node]; j < graph->offsets[node + 1]; j++) {
+					NodeID neighbor = graph->targets[j];
+					
+					// If going through this node is a shorter way to the neighbor
+					if (distance + graph->GetWeight(j) < forward.distances[neighbor]) {
+						Reach(forward, neighbor, distance + graph->GetWeight(j), node);
+						forward.heap.PushOrDecrease(neighbor, forward.distances[neighbor] + heuristic(neighbor));
+					}
+				}
+			}
+			
+			// Follow the parents back from the target
+			if (path != NULL && best != InfiniteWeight) {
+				for (NodeID at = target; at != -1; at = forward.parents[at]) {
+					path->push_back(at);
+				}
+				
+				std::reverse(path->begin(), path->end());
+			}
+			
+			return best;
+		}
+}; // End PathQuery Class
+
+#endif
@@ -0,0 +1,235 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <vector> // For the vector class
+#include <utility> // For the pair class
+#include <stdint.h> // For the fixed width integer types
+#include "RadixSort.h" // For the WeightToKey function
+
+// RadixHeap
+// This is a monotone priority queue over the integer IDs 0 to capacity - 1
+// with non-negative Weight keys. Entries are kept in one bucket per bit of
+// the encoded key plus one, by the highest bit their key differs from the
+// last popped key in, so a push is constant time and every entry is only
+// moved between buckets a handful of times.
+// Keys must never be pushed below the last popped key, which always holds
+// for Dijkstra's algorithm with non-negative weights. Lowering a key pushes
+// a new entry and the old one is skipped when it comes out. It offers the
+// same interface as the IndexedHeap so either can be used as the queue.
+class RadixHeap {
+	private:
+		typedef std::pair<WeightKey, NodeID> Entry; // An encoded key and its ID
+		
+		static const int Buckets = 8 * sizeof(WeightKey) + 1; // The amount of buckets
+		
+		std::vector<Entry> buckets[Buckets]; // Bucket 0 holds the keys equal to the last key
+		std::vector<Weight> keys;            // The key of each ID
+		std::vector<char> queued;            // Is a flag per ID if it is in the heap
+		WeightKey last;                      // The encoded key of the last popped ID
+		NodeID size;                         // The amount of IDs in the heap
+		
+		// GetBucket
+		// params:
+		//	key: This is the encoded key
+		// Returns the bucket the key belongs in
+		int GetBucket(WeightKey key) const {
+			WeightKey differ = key ^ last;
+			int bucket = 0;
+			
+			// Find the highest bit the key differs from the last key in
+#if defined(__GNUC__)
+			bucket = (differ == 0 ? 0 : Buckets - 1 - (sizeof(differ) > 4 ? __builtin_clzll(differ) : __builtin_clz(differ)));
+#else
+			while (differ != 0) {
+				differ >>= 1;
+				bucket++;
+			}
+#endif
+
+			return bucket;
+		}
+		
+		// Refill
+		// Moves the entries with the smallest key into bucket 0, returns
+		// false if there are no entries left
+		bool Refill() {
+			int bucket = 1;
+			
+			// Find the first bucket with anything in it
+			while (bucket < Buckets && buckets[bucket].size() == 0) {
+				bucket++;
+			}
+			
+			if (bucket == Buckets) {
+				return false;
+			}
+			
+			// The smallest key in it becomes the last key
+			std::vector<Entry> & from = buckets[bucket];
+			last = from[0].first;
+			
+			for (uint64_t i = 1; i < from.size(); i++) {
+				if (from[i].first < last) {
+					last = from[i].first;
+				}
+			}
+			
+			// Every entry now differs from the last key in a lower bit
+			for (uint64_t i = 0; i < from.size(); i++) {
+				buckets[GetBucket(from[i].first)].push_back(from[i]);
+			}
+			
+			from.clear();
+			
+			return true;
+		}
+	
+	public:
+		// Parameterized Constructor
+		// params:
+		//	capacity: This is the amount of IDs the heap can hold
+		// Initializes an empty heap for the IDs 0 to capacity - 1
+		RadixHeap(NodeID capacity = 0) {
+			Resize(capacity);
+			return;
+		}
+		
+		// Resize
+		// params:
+		//	capacity: This is the amount of IDs the heap can hold
+		// Empties the heap and makes room for the IDs 0 to capacity - 1
+		void Resize(NodeID capacity) {
+			for (int i = 0; i < Buckets; i++) {
+				buckets[i].clear();
+			}
+			
+			keys.resize(capacity);
+			queued.assign(capacity, 0);
+			last = 0;
+			size = 0;
+			
+			return;
+		}
+		
+		// Push
+		// params:
+		//	id: This is the ID to add
+		//	key: This is the key of the ID, not below the last popped key
+		// Adds the ID to the heap, returns false if it is already there
+		bool Push(NodeID id, Weight key) {
+			bool pushed = false;
+			
+			// If the ID is not already in the heap
+			if (!queued[id]) {
+				keys[id] = key;
+				queued[id] = 1;
+				size++;
+				
+				buckets[GetBucket(WeightToKey(key))].push_back(Entry(WeightToKey(key), id));
+				
+				pushed = true;
+			}
+			
+			return pushed;
+		}
+		
+		// DecreaseKey
+		// params:
+		//	id: This is the ID whose key is lowered
+		//	key: This is the new key of the ID, not below the last popped key
+		// Lowers the key of an ID already in the heap, returns false if the
+		// ID is not in the heap or the key is not smaller
+		bool DecreaseKey(NodeID id, Weight key) {
+			bool decreased = false;
+			
+			// If the ID is in the heap and the key is smaller
+			if (queued[id] && keys[id] > key) {
+				keys[id] = key;
+				
+				// The old entry is left behind and skipped when it comes out
+				buckets[GetBucket(WeightToKey(key))].push_back(Entry(WeightToKey(key), id));
+				
+				decreased = true;
+			}
+			
+			return decreased;
+		}
+		
+		// PushOrDecrease
+		// params:
+		//	id: This is the ID to add or lower
+		//	key: This is the key of the ID, not below the last popped key
+		// Adds the ID if it is not in the heap, otherwise lowers its key.
+		// Returns true if the heap changed.
+		bool PushOrDecrease(NodeID id, Weight key) {
+			return (queued[id] ? DecreaseKey(id, key) : Push(id, key));
+		}
+		
+		// Pop
+		// Removes the ID with the smallest key from the heap and returns it,
+		// returns -1 if the heap is empty
+		NodeID Pop() {
+			// While there are entries left
+			while (size > 0 && (buckets[0].size() != 0 || Refill())) {
+				Entry entry = buckets[0].back();
+				buckets[0].pop_back();
+				
+				// If this is the current entry of a queued ID it is the smallest
+				if (queued[entry.second] && WeightToKey(keys[entry.second]) == entry.first) {
+					queued[entry.second] = 0;
+					size--;
+					
+					return entry.second;
+				}
+			}
+			
+			return -1;
+		}
+		
+		// GetKey
+		// params:
+		//	id: This is the ID whose key we want
+		// Returns the last key given to the ID
+		Weight GetKey(NodeID id) const {
+			return keys[id];
+		}
+		
+		// Contains
+		// params:
+		//	id: This is the ID we are looking for
+		// Returns true if the ID is in the heap, false otherwise
+		bool Contains(NodeID id) const {
+			return (queued[id] != 0);
+		}
+		
+		// Size
+		// Returns the amount of IDs in the heap
+		NodeID Size() const {
+			return size;
+		}
+		
+		// Empty
+		// Returns true if the heap is empty, false otherwise
+		bool Empty() const {
+			return (size == 0);
+		}
+		
+		// Clear
+		// Removes all IDs from the heap, only touching the entries in it
+		void Clear() {
+			for (int i = 0; i < Buckets; i++) {
+				for (uint64_t j = 0; j < buckets[i].size(); j++) {
+					queued[buckets[i][j].second] = 0;
+				}
+				
+				buckets[i].clear();
+			}
+			
+			last = 0;
+			size = 0;
+			
+			return;
+		}
+};
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <vector> // For the vector class
+#include <algorithm> // For the fill function
+#include <cstring> // For memcpy
+#include <stdint.h> // For the fixed width integer types
+#include <limits> // For the numeric_limits class
+#include <type_traits> // For the conditional and decay classes
+#include "Edge.h" // For the Weight type
+#include "Parallel.h" // For the ParallelThreads function
+
+// FloatToKey
+// params:
+//	value: This is the float to convert
+// Returns an unsigned key that sorts in the same order as the float.
+// Positive floats get their sign bit set and negative floats have every
+// bit flipped, so the keys order correctly as plain integers.
+inline uint32_t FloatToKey(float value) {
+	uint32_t bits;
+	
+	memcpy(&bits, &value, sizeof(bits));
+	
+	return ((bits & 0x80000000u) ? ~bits : (bits | 0x80000000u));
+}
+
+// KeyToFloat
+// params:
+//	key: This is a key made by FloatToKey
+// Returns the float the key was made from
+inline float KeyToFloat(uint32_t key) {
+	uint32_t bits = ((key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key);
+	float value;
+	
+	memcpy(&value, &bits, sizeof(value));
+	
+	return value;
+}
+
+// WeightKey
+// This is the unsigned key WeightToKey turns a Weight into, as wide as the Weight
+typedef std::conditional<(sizeof(Weight) > 4), uint64_t, uint32_t>::type WeightKey;
+
+// WeightToKey
+// params:
+//	value: This is the weight to convert
+// Returns an unsigned key that sorts in the same order as the weight.
+// Floating point weights are flipped the same way as FloatToKey and signed
+// integer weights get their sign bit flipped.
+inline WeightKey WeightToKey(Weight value) {
+	const WeightKey sign = (WeightKey)1 << (8 * sizeof(WeightKey) - 1);
+	WeightKey bits = 0;
+	
+	if (std::numeric_limits<Weight>::is_iec559) {
+		memcpy(&bits, &value, sizeof(value));
+		
+		return ((bits & sign) ? ~bits : (bits | sign));
+	}
+	
+	return (std::numeric_limits<Weight>::is_signed ? (WeightKey)value ^ sign : (WeightKey)value);
+}
+
+// KeyToWeight
+// params:
+//	key: This is a key made by WeightToKey
+// Returns the weight the key was made from
+inline Weight KeyToWeight(WeightKey key) {
+	const WeightKey sign = (WeightKey)1 << (8 * sizeof(WeightKey) - 1);
+	Weight value;
+	
+	if (std::numeric_limits<Weight>::is_iec559) {
+		WeightKey bits = ((key & sign) ? (key & ~sign) : ~key);
+		
+		memcpy(&value, &bits, sizeof(value));
+		
+		return value;
+	}
+	
+	return (Weight)(std::numeric_limits<Weight>::is_signed ? key ^ sign : key);
+}
+
+// RadixSort
+// params:
+//	items: This is the list of items to sort
+//	key: This is called as key(item) and returns the items unsigned key,
+//	     a uint32_t or a uint64_t
+//	threads: This is the amount of threads to use, 0 uses every core and
+//	         1 sorts on the calling thread
+// Performs a stable least significant digit radix sort on the items, one
+// byte of the key per pass. Passes where every key shares the same byte are
+// skipped. Each thread counts and scatters its own contiguous chunk, so the
+// parallel sort stays stable.
+template <class T, class KeyFunction>
+void RadixSort(std::vector<T> & items, KeyFunction key, int threads = 0) {
+	typedef typename std::decay<decltype(key(items[0]))>::type Key;
+	const int radix = 256;
+	const uint64_t minChunk = 65536;
+	uint64_t size = items.size();
+	std::vector<T> buffer(items); // Copied rather than sized as T may not be default constructible
+	T * from = items.data(), * to = buffer.data();
+	
+	if (threads < 1) {
+		threads = GetNumThreads();
+	}
+	
+	// Small lists are not worth starting threads for
+	if (size / minChunk < (uint64_t)threads) {
+		threads = (size / minChunk > 0 ? size / minChunk : 1);
+	}
+	
+	// Split the items into one contiguous chunk per thread
+	uint64_t chunk = (size + threads - 1) / threads;
+	std::vector<uint64_t> counts((uint64_t)threads * radix);
+	
+	// For every byte of the key, least significant first
+	for (int shift = 0; shift < 8 * (int)sizeof(Key); shift += 8) {
+		bool skip = false;
+		
+		// Count how many keys each thread has for every digit
+		std::fill(counts.begin(), counts.end(), 0);
+		ParallelThreads([&](int thread, int count) {
+			uint64_t first = chunk * thread, last = (first + chunk < size ? first + chunk : size);
+			uint64_t * mine = &counts[(uint64_t)thread * radix];
+			
+			for (uint64_t i = first; i < last; i++) {
+				mine[(key(from[i]) >> shift) & (radix - 1)]++;
+			}
+		}, threads);
+		
+		// Turn the counts into where every thread writes every digit,
+		// digits in order and threads in order within each digit
+		uint64_t total = 0;
+		for (int digit = 0; digit < radix; digit++) {
+			uint64_t inDigit = 0;
+			
+			for (int thread = 0; thread < threads; thread++) {
+				uint64_t count = counts[(uint64_t)thread * radix + digit];
+				
+				counts[(uint64_t)thread * radix + digit] = total;
+				total += count;
+				inDigit += count;
+			}
+			
+			// If every key has this digit the pass would not move anything
+			if (inDigit == size) {
+				skip = true;
+			}
+		}
+		
+		if (skip) {
+			continue;
+		}
+		
+		// Scatter every thread's chunk into place
+		ParallelThreads([&](int thread, int count) {
+			uint64_t first = chunk * thread, last = (first + chunk < size ? first + chunk : size);
+			uint64_t * mine = &counts[(uint64_t)thread * radix];
+			
+			for (uint64_t i = first; i < last; i++) {
+				to[mine[(key(from[i]) >> shift) & (radix - 1)]++] = from[i];
+			}
+		}, threads);
+		
+		// The next pass reads what this one wrote
+		T * temp = from;
+		from = to;
+		to = temp;
+	}
+	
+	// If the sorted items ended up in the buffer move them back
+	if (from != items.data()) {
+		items.swap(buffer);
+	}
+	
+	return;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef SHORTEST_PATH_TREE_H
+#define SHORTEST_PATH_TREE_H
+
+#include <vector> // For the vector class
+#include <algorithm> // For the reverse function
+#include "Edge.h" // For the NodeID and Weight types
+
+// ShortestPathQueue
+// These are the priority queues the shortest path searches can run on
+enum ShortestPathQueue {
+	IndexedHeapQueue, // The d-ary IndexedHeap, works with any non-negative weights
+	RadixHeapQueue    // The monotone RadixHeap, fastest on small integer-like weights
+};
+
+// ShortestPathTree
+// This holds the result of a single source shortest path search, the
+// distance to every node and the node before it on its shortest path.
+// Nodes that were not reached have an infinite distance and a parent of -1.
+struct ShortestPathTree {
+	NodeID source;                // The node the search started from
+	std::vector<Weight> distances; // The distance from the source to every node
+	std::vector<NodeID> parents;  // The node before every node on its path, -1 if there is none
+	
+	// Reached
+	// params:
+	//	node: This is the node we are looking for
+	// Returns true if the search found a path to the node
+	bool Reached(NodeID node) const {
+		return (node >= 0 && node < (NodeID)parents.size() && (node == source || parents[node] != -1));
+	}
+	
+	// GetPath
+	// params:
+	//	target: This is the node the path ends at
+	// Returns the nodes on the path from the source to the target, empty
+	// if the target was not reached
+	std::vector<NodeID> GetPath(NodeID target) const {
+		std::vector<NodeID> path;
+		
+		if (Reached(target)) {
+			// Walk back from the target to the source
+			for (NodeID node = target; node != -1; node = parents[node]) {
+				path.push_back(node);
+			}
+			
+			std::reverse(path.begin(), path.end());
+		}
+		
+		return path;
+	}
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef SPANNING_FOREST_H
+#define SPANNING_FOREST_H
+
+#include <vector> // For the vector class
+#include "Node.h" // For the Node class and the AdjList and EdgeList types
+
+// SpanningForest
+// This holds the result of a minimum spanning forest algorithm as a flat
+// list with every forest edge once, in the order the algorithm took it,
+// and the total weight of those edges. It is a fraction of the size of an
+// adjacency list of the forest, which ToAdjList builds when one is wanted.
+// Refilling the same forest reuses the memory of its list.
+struct SpanningForest {
+	NodeID vertices; // The amount of nodes the forest spans
+	EdgeList edges;  // Every forest edge once
+	Weight weight;   // The total weight of the forest edges
+	
+	// Default Constructor
+	// Creates an empty forest
+	SpanningForest() : vertices(0), weight(0) {
+		return;
+	}
+	
+	// Reset
+	// params:
+	//	vertices: This is the amount of nodes the forest will span
+	// Empties the forest, keeping the memory of its list
+	void Reset(NodeID vertices) {
+		this->vertices = vertices;
+		edges.clear();
+		weight = 0;
+		
+		return;
+	}
+	
+	// Add
+	// params:
+	//	edge: This is the forest edge to add
+	// Adds the edge to the forest and its weight to the total
+	void Add(const Edge & edge) {
+		edges.push_back(edge);
+		weight += edge.GetWeight();
+		
+		return;
+	}
+	
+	// ToAdjList
+	// Returns the forest as an adjacency list with a node per vertex and
+	// every forest edge going both ways, added in the order of the list
+	AdjList ToAdjList() const {
+		AdjList mst;
+		std::vector<int> degrees(vertices, 0);
+		
+		// Count the edges of every node so each is sized once
+		for (NodeID i = 0; i < edges.size(); i++) {
+			degrees[edges[i].GetStartID()]++;
+			degrees[edges[i].GetID()]++;
+		}
+		
+		mst.reserve(vertices);
+		for (NodeID i = 0; i < vertices; i++) {
+			mst.push_back(Node(i));
+			mst.back().ReserveEdges(degrees[i]);
+		}
+		
+		// Add a bidirectional connection for every forest edge, a forest
+		// never holds the same pair twice so nothing has to be checked
+		for (NodeID i = 0; i < edges.size(); i++) {
+			mst[edges[i].GetStartID()].AppendEdge(edges[i].GetID(), edges[i].GetWeight());
+			mst[edges[i].GetID()].AppendEdge(edges[i].GetStartID(), edges[i].GetWeight());
+		}
+		
+		// High degree nodes get their neighbor index straight away
+		for (NodeID i = 0; i < vertices; i++) {
+			if (mst[i].GetDegree() > Node::IndexThreshold) {
+				mst[i].BuildIndex();
+			}
+		}
+		
+		return mst;
+	}
+};
+
+#endif
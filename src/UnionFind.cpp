@@ -4,37 +4,36 @@
 // params:
 //	size: This is the total size of elements that will be watched
 // Creates a UnionFind data structure for (size) elements
-UnionFind::UnionFind(const int & size) {
+UnionFind::UnionFind(const NodeID & size) {
+	Reset(size);
+	return;
+}
+
+// Reset
+// params:
+//	size: This is the total size of elements that will be watched
+// Puts every one of (size) elements back into its own set
+void UnionFind::Reset(const NodeID & size) {
 	// Allocate memory for the sets
-	parents = new int[size];
-	treeSize = new int[size];
+	parents.resize(size);
+	treeSize.assign(size, 1);
+	sets = size;
 	
 	// For every element we are tracking
-	for (int i = 0; i < size; i++) {
+	for (NodeID i = 0; i < size; i++) {
 		// Set their parent to themselves
-		// and their set size to one
 		parents[i] = i;
-		treeSize[i] = 1;
 	}
 	
 	return;
 }
 
-// Destructor
-// Ensures the freeing of all allocated memory
-UnionFind::~UnionFind() {
-	delete [] parents;
-	delete [] treeSize;
-	
-	return;
-}
-
 // Union
 // params:
 //	one: This is an element in the first set to merge
 //	two: This is an element in the second set to merge
 // Merge two sets togethers
-bool UnionFind::Union(int one, int two) {
+bool UnionFind::Union(NodeID one, NodeID two) {
 	bool unioned = false;
 	
 	// Find the roots of the elements
@@ -56,6 +55,7 @@ bool UnionFind::Union(int one, int two) {
 			treeSize[one] += treeSize[two];
 		}
 		
+		sets--;
 		unioned = true;
 	}
 	
@@ -66,14 +66,36 @@ bool UnionFind::Union(int one, int two) {
 // params:
 //	one: This is the element we are looking to find
 //	Returns the root of the set that this element is in
-int UnionFind::Find(int one) {
-	int root = one;
+NodeID UnionFind::Find(NodeID one) {
+	NodeID root = one;
 	
 	// While the elements parent is not itself
 	while (root != parents[root]) {
-		// Set the new root to the elements parent
+		// Point the element at its grandparent, halving the path
+		// for the next Find, and move up to it
+		parents[root] = parents[parents[root]];
 		root = parents[root];
 	}
 	
 	return root;
-}
\ No newline at end of file
+}
+
+// GetSetSize
+// params:
+//	one: This is an element of the set
+// Returns the amount of elements in the set this element is in
+NodeID UnionFind::GetSetSize(NodeID one) {
+	return treeSize[Find(one)];
+}
+
+// GetNumSets
+// Returns the amount of disjoint sets
+NodeID UnionFind::GetNumSets() const {
+	return sets;
+}
+
+// GetNumElements
+// Returns the amount of elements being watched
+NodeID UnionFind::GetNumElements() const {
+	return parents.size();
+}
@@ -1,39 +1,61 @@
 #ifndef UNION_FIND_H
 #define UNION_FIND_H
 
+#include <vector> // For the vector class
+#include "Edge.h" // For the NodeID type
+
 // UnionFind
 // The UnionFind data structure acts a set management utility
 // where you can detect the sets of a given value and merge sets.
-// This is used for Kruskal's Algorithm
+// Sets are merged by size and Find halves the path it walks, so
+// every operation is close to constant time. This is used for
+// Kruskal's Algorithm
 
 class UnionFind {
 	private:
-		int * parents,  // Used to create a parent array for all elements 
-			* treeSize; // Tracks the size of the sets element is in
+		std::vector<NodeID> parents,  // Used to create a parent array for all elements
+							treeSize; // Tracks the size of the sets element is in
+		NodeID sets;                  // Tracks the amount of disjoint sets
 		
 	public:
 		// Default Constructor
 		// params:
 		//	size: This is the total size of elements that will be watched
 		// Creates a UnionFind data structure for (size) elements
-		UnionFind(const int & size);
+		UnionFind(const NodeID & size = 0);
 		
-		// Destructor
-		// Ensures the freeing of all allocated memory
-		~UnionFind();
+		// Reset
+		// params:
+		//	size: This is the total size of elements that will be watched
+		// Puts every one of (size) elements back into its own set
+		void Reset(const NodeID & size);
 		
 		// Union
 		// params:
 		//	one: This is an element in the first set to merge
 		//	two: This is an element in the second set to merge
 		// Merge two sets togethers
-		bool Union(int one, int two);
+		bool Union(NodeID one, NodeID two);
 		
 		// Find
 		// params:
 		//	one: This is the element we are looking to find
 		//	Returns the root of the set that this element is in
-		int Find(int one);
+		NodeID Find(NodeID one);
+		
+		// GetSetSize
+		// params:
+		//	one: This is an element of the set
+		// Returns the amount of elements in the set this element is in
+		NodeID GetSetSize(NodeID one);
+		
+		// GetNumSets
+		// Returns the amount of disjoint sets
+		NodeID GetNumSets() const;
+		
+		// GetNumElements
+		// Returns the amount of elements being watched
+		NodeID GetNumElements() const;
 };
 
-#endif
\ No newline at end of file
+#endif
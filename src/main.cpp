@@ -1,22 +1,64 @@
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <cmath>
+#include <vector>
 #include "Graph.h"
 #include "UnionFind.h"
+#include "ConcurrentUnionFind.h"
+#include "Parallel.h"
 #include "Heap.h"
+#include "IndexedHeap.h"
+#include "RadixHeap.h"
+#include "EdgeArena.h"
+#include "GraphBuilder.h"
+#include "EdgeListReader.h"
+#include "PathQuery.h"
+#include "ContractionHierarchy.h"
 
 using namespace std;
 
 void TestUnionFindClass();
+void TestConcurrentUnionFindClass();
 void TestGraphClass();
 void TestEdgeClass();
 void TestNodeClass();
 void TestHeapClass();
+void TestIndexedHeapClass();
+void TestRadixHeapClass();
+void TestEdgeArenaClass();
+void TestCsrGraphClass();
+void TestGraphBuilderClass();
+void TestEdgeListReaderClass();
+void TestPathQueryClass();
+void TestContractionHierarchyClass();
+void BenchmarkUnionFind();
+void BenchmarkDeltaStepping();
 
-int main () {
+// Running with "bench" runs the benchmarks instead of the tests
+int main (int argc, char ** argv) {
+	if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+		BenchmarkUnionFind();
+		BenchmarkDeltaStepping();
+		return 0;
+	}
+	
 	TestUnionFindClass();
+	TestConcurrentUnionFindClass();
 	TestHeapClass();
+	TestIndexedHeapClass();
+	TestRadixHeapClass();
+	TestEdgeArenaClass();
 	TestEdgeClass();
 	TestNodeClass();
 	TestGraphClass();
+	TestCsrGraphClass();
+	TestGraphBuilderClass();
+	TestEdgeListReaderClass();
+	TestPathQueryClass();
+	TestContractionHierarchyClass();
 	
 	return 0;
 }
@@ -63,6 +105,13 @@ void TestGraphClass() {
 	cout << "Printing the graph class" << endl;
 	g.Print();
 	
+	cout << "Weakly connected components:";
+	vector<NodeID> components = g.ConnectedComponents();
+	for (int i = 0; i < components.size(); i++) {
+		cout << " " << components[i];
+	}
+	cout << endl;
+	
 	cout << "Removing all directional links" << endl;
 	g.RemoveEdge(3, 0);
 	g.RemoveEdge(3, 2);
@@ -76,6 +125,35 @@ void TestGraphClass() {
 	cout << "V: " << g.GetNumVertices() << "\t\tE: " << g.GetNumEdges() << endl;
 	cout << "Printing the graph class" << endl;
 	g.Print();
+	
+	cout << "Adding the directional link (3, 1), which goes with node 1" << endl;
+	g.AddEdge(3, 1, 2, true);
+	
+	cout << "Removing node 1, the other IDs stay the same" << endl;
+	g.RemoveNode(1);
+	cout << "V: " << g.GetNumVertices() << "\t\tE: " << g.GetNumEdges() << "\t\tRemoved IDs: " << g.GetNumRemoved() << endl;
+	cout << "Contains node 1? " << (g.Contains(1) ? "Yes" : "No") << "\tContains node 2? " << (g.Contains(2) ? "Yes" : "No") << endl;
+	g.Print();
+	
+	cout << "Compacting the graph, new IDs:";
+	vector<NodeID> newIDs = g.Compact();
+	for (int i = 0; i < newIDs.size(); i++) {
+		cout << " " << newIDs[i];
+	}
+	cout << endl;
+	cout << "V: " << g.GetNumVertices() << "\t\tE: " << g.GetNumEdges() << "\t\tRemoved IDs: " << g.GetNumRemoved() << endl;
+	g.Print();
+	cout << endl;
+	
+	cout << "Removing a node with 50000 one way links into it" << endl;
+	Graph hub;
+	hub.AddNode();
+	for (int i = 1; i <= 50000; i++) {
+		hub.AddNode();
+		hub.AddEdge(i, 0, 1, true);
+	}
+	hub.RemoveNode(0);
+	cout << "V: " << hub.GetNumVertices() << "\t\tE: " << hub.GetNumEdges() << endl;
 	cout << endl;
 	
 	cout << "Setting up a new graph for the algorithms..." << endl;
@@ -128,6 +206,23 @@ void TestGraphClass() {
 		cout << endl;
 	}
 	
+	cout << endl << "Finding the shortest path from 1 to 5" << endl;
+	vector<NodeID> path;
+	cout << "Length: " << g.ShortestPath(1, 5, &path) << "\tPath:";
+	for (int i = 0; i < path.size(); i++) {
+		cout << " " << path[i];
+	}
+	cout << endl;
+	
+	cout << "Adding an edge from 1 to 5 weighing 1 and finding the path again" << endl;
+	g.AddEdge(1, 5, 1);
+	cout << "Length: " << g.ShortestPath(1, 5, &path) << "\tPath:";
+	for (int i = 0; i < path.size(); i++) {
+		cout << " " << path[i];
+	}
+	cout << endl;
+	g.RemoveEdge(1, 5);
+	
 	cout << endl;
 	cout << "Setting up a new graph for the algorithms in a different order..." << endl;
 	g.Clear();
@@ -238,6 +333,29 @@ void TestGraphClass() {
 		cout << endl;
 	}
 	
+	cout << endl << "Maintaining the MST while the graph changes" << endl;
+	g.MaintainMST();
+	cout << "Maintaining? " << (g.IsMaintainingMST() ? "Yes" : "No") << endl;
+	
+	cout << "Adding an edge from 1 to 5 weighing -1, it replaces the edge from 0 to 3" << endl;
+	g.AddEdge(1, 5, -1);
+	cout << "Removing the edge from 3 to 5, the edge from 0 to 3 replaces it" << endl;
+	g.RemoveEdge(3, 5);
+	
+	for (int i = 0; i < g.GetMST().size(); i++) {
+		g.GetMST()[i].Print();
+		cout << endl;
+	}
+	
+	cout << "Kruskals Algorithm on the changed graph for comparison" << endl;
+	el =  g.KruskalsAlgorithm();
+	for (int i = 0; i < el.size(); i++) {
+		el[i].Print();
+		cout << endl;
+	}
+	
+	g.MaintainMST(false);
+	
 	return;
 }
 
@@ -325,6 +443,27 @@ void TestNodeClass() {
 	n.Print();
 	cout << endl;
 	
+	cout << "Creating a high degree node with 100 edges..." << endl;
+	Node hub(0);
+	for (int i = 1; i <= 100; i++) {
+		hub.AddEdge(i, i);
+	}
+	
+	cout << "Adding a duplicate edge (50) rejected? " << (hub.AddEdge(50, 1) ? "No" : "Yes") << endl;
+	
+	cout << "Removing every even edge..." << endl;
+	for (int i = 2; i <= 100; i += 2) {
+		hub.RemoveEdge(i);
+	}
+	
+	cout << "Checking the contains edge (51) function: " << (hub.ContainsEdge(51) ? "true" : "false") << endl;
+	cout << "Checking the contains edge (52) function: " << (hub.ContainsEdge(52) ? "true" : "false") << endl;
+	
+	cout << "Update an edge weight (51 to 7 wght)... " << endl;
+	hub.UpdateEdge(51, 51, false, 7);
+	cout << "Degree after removals: " << hub.GetNeighbors().Size() << endl;
+	cout << endl;
+	
 	return;
 }
 
@@ -396,8 +535,809 @@ void TestUnionFindClass() {
 	cout << "2: " << uf.Find(2) << endl;
 	
 	cout << "Trying to merge 1 and 2... Successful?" << (uf.Union(1, 2) ? " Yes" : " No") << endl;
+	cout << "Sets: " << uf.GetNumSets() << "\t\tSize of the set of 2: " << uf.GetSetSize(2) << endl;
+	
+	cout << "Copying the structure and merging 0 into the copy" << endl;
+	UnionFind copy(uf);
+	copy.Union(0, 2);
+	cout << "Sets in the copy: " << copy.GetNumSets() << "\tSets in the original: " << uf.GetNumSets() << endl;
+	
+	cout << endl;
+	
+	return;
+}
+
+// TestConcurrentUnionFindClass
+// Performs tests on all public ConcurrentUnionFind class functions
+void TestConcurrentUnionFindClass() {
+	cout << " ---------- Testing the ConcurrentUnionFind class" << endl;
+	
+	ConcurrentUnionFind uf(6);
+	
+	cout << "Merging (4, 5) (5, 2) and (1, 3)" << endl;
+	uf.Union(4, 5);
+	uf.Union(5, 2);
+	uf.Union(1, 3);
+	
+	cout << "Roots:";
+	for (int i = 0; i < uf.GetNumElements(); i++) {
+		cout << " " << uf.Find(i);
+	}
+	cout << endl;
+	
+	cout << "Are 2 and 4 in the same set? " << (uf.SameSet(2, 4) ? "Yes" : "No") << endl;
+	cout << "Are 0 and 1 in the same set? " << (uf.SameSet(0, 1) ? "Yes" : "No") << endl;
+	
+	cout << "Merging a chain of 1000000 elements from every thread at once" << endl;
+	const int size = 1000000;
+	uf.Reset(size);
+	ParallelThreads([&](int thread, int count) {
+		for (int i = thread; i + 1 < size; i += count) {
+			uf.Union(i, i + 1);
+		}
+	});
+	
+	int roots = 0;
+	for (int i = 0; i < size; i++) {
+		roots += (uf.Find(i) == i);
+	}
+	cout << "Sets left: " << roots << "\tRoot of the last element: " << uf.Find(size - 1) << endl;
+	
+	cout << endl;
+	
+	return;
+}
+
+// BaselineUnionFind
+// The UnionFind as it was before path halving, kept to benchmark against
+struct BaselineUnionFind {
+	std::vector<int> parents, treeSize;
+	
+	BaselineUnionFind(int size) : parents(size), treeSize(size, 1) {
+		for (int i = 0; i < size; i++) {
+			parents[i] = i;
+		}
+	}
+	
+	int Find(int one) {
+		while (one != parents[one]) {
+			one = parents[one];
+		}
+		
+		return one;
+	}
+	
+	bool Union(int one, int two) {
+		one = Find(one);
+		two = Find(two);
+		
+		if (one == two) {
+			return false;
+		}
+		
+		if (treeSize[one] < treeSize[two]) {
+			parents[one] = two;
+			treeSize[two] += treeSize[one];
+		} else {
+			parents[two] = one;
+			treeSize[one] += treeSize[two];
+		}
+		
+		return true;
+	}
+};
+
+// BenchmarkUnionFind
+// Times random unions followed by random finds on the baseline, the
+// path halving UnionFind and the ConcurrentUnionFind
+void BenchmarkUnionFind() {
+	const int size = 4000000, operations = 16000000;
+	std::vector<int> pairs(2 * operations);
+	std::chrono::steady_clock::time_point start;
+	volatile long long check; // Keeps the finds from being optimized out
+	
+	cout << " ---------- Benchmarking the UnionFind classes" << endl;
+	cout << size << " elements, " << operations << " unions then " << operations << " finds" << endl;
+	
+	srand(42);
+	for (int i = 0; i < pairs.size(); i++) {
+		pairs[i] = ((long long)rand() * RAND_MAX + rand()) % size;
+	}
+	
+	BaselineUnionFind baseline(size);
+	start = std::chrono::steady_clock::now();
+	check = 0;
+	for (int i = 0; i < operations; i++) {
+		baseline.Union(pairs[2 * i], pairs[2 * i + 1]);
+	}
+	for (int i = 0; i < operations; i++) {
+		check += baseline.Find(pairs[i]);
+	}
+	cout << "Baseline UnionFind:\t\t" << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s" << endl;
+	
+	UnionFind uf(size);
+	start = std::chrono::steady_clock::now();
+	check = 0;
+	for (int i = 0; i < operations; i++) {
+		uf.Union(pairs[2 * i], pairs[2 * i + 1]);
+	}
+	for (int i = 0; i < operations; i++) {
+		check += uf.Find(pairs[i]);
+	}
+	cout << "Path halving UnionFind:\t\t" << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s" << endl;
+	
+	for (int threads = 1; threads <= GetNumThreads(); threads *= 2) {
+		ConcurrentUnionFind cuf(size);
+		start = std::chrono::steady_clock::now();
+		ParallelFor(0, operations, [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				cuf.Union(pairs[2 * i], pairs[2 * i + 1]);
+			}
+		}, threads);
+		ParallelFor(0, operations, [&](int thread, uint64_t first, uint64_t last) {
+			for (uint64_t i = first; i < last; i++) {
+				cuf.Find(pairs[i]);
+			}
+		}, threads);
+		cout << "ConcurrentUnionFind " << threads << " threads:\t" << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s" << endl;
+	}
 	
 	cout << endl;
 	
 	return;
-}
\ No newline at end of file
+}
+
+// TestCsrGraphClass
+// Performs tests on all public CsrGraph class functions
+void TestCsrGraphClass() {
+	cout << " ---------- Testing the CsrGraph class" << endl;
+	
+	Graph g;
+	
+	for (int i = 0; i < 6; i++) {
+		g.AddNode();
+	}
+	
+	g.AddEdge(0, 1, 1);
+	g.AddEdge(0, 2, 4);
+	g.AddEdge(0, 3, 1);
+	g.AddEdge(1, 4, 7);
+	g.AddEdge(2, 3, 2);
+	g.AddEdge(2, 4, 4);
+	g.AddEdge(2, 5, 1);
+	g.AddEdge(3, 4, 1);
+	g.AddEdge(3, 5, 7);
+	
+	cout << "Freezing the graph into a CsrGraph" << endl;
+	CsrGraph csr = g.Freeze();
+	cout << "V: " << csr.GetNumVertices() << "\t\tE: " << csr.GetNumEdges() << endl;
+	csr.Print();
+	
+	cout << "Degree of node 2: " << csr.GetDegree(2) << endl;
+	cout << "Neighbors of node 2:";
+	for (EdgeIndex i = csr.GetBegin(2); i < csr.GetEnd(2); i++) {
+		cout << " " << csr.GetTarget(i) << "(" << csr.GetWeight(i) << ")";
+	}
+	cout << endl;
+	
+	cout << "Finding the edge (2, 4)... Index: " << csr.FindEdge(2, 4) << endl;
+	cout << "Finding the edge (1, 5)... Found? " << (csr.FindEdge(1, 5) != csr.GetNumEdges() ? "Yes" : "No") << endl;
+	
+	cout << endl << "Running Kruskals Algorithm on the snapshot" << endl;
+	AdjList el = csr.KruskalsAlgorithm();
+	for (int i = 0; i < el.size(); i++) {
+		el[i].Print();
+		cout << endl;
+	}
+	
+	cout << endl << "Running Filter-Kruskal on the snapshot" << endl;
+	AdjList fk = csr.FilterKruskalAlgorithm();
+	for (int i = 0; i < fk.size(); i++) {
+		fk[i].Print();
+		cout << endl;
+	}
+	
+	cout << endl << "Running Boruvkas Algorithm on the snapshot" << endl;
+	AdjList bv = csr.BoruvkaAlgorithm();
+	for (int i = 0; i < bv.size(); i++) {
+		bv[i].Print();
+		cout << endl;
+	}
+	
+	cout << endl << "Running Prims Algorithm on the snapshot" << endl;
+	el = csr.PrimsAlgorithm();
+	for (int i = 0; i < el.size(); i++) {
+		el[i].Print();
+		cout << endl;
+	}
+	
+	cout << endl << "Running Kruskals Algorithm on the snapshot into a flat forest" << endl;
+	SpanningForest forest;
+	csr.KruskalsAlgorithm(forest);
+	for (int i = 0; i < forest.edges.size(); i++) {
+		forest.edges[i].Print();
+		cout << endl;
+	}
+	cout << "Total weight: " << forest.weight << endl;
+	
+	cout << "Refilling the forest with Boruvkas Algorithm... Same edges? ";
+	EdgeList kruskal = forest.edges;
+	csr.BoruvkaAlgorithm(forest);
+	cout << (forest.edges == kruskal ? "Yes" : "No") << endl;
+	
+	cout << "Running Prims Algorithm on the snapshot into a parent array" << endl;
+	std::vector<NodeID> parents;
+	Weight weight = csr.PrimsAlgorithm(parents);
+	for (int i = 0; i < parents.size(); i++) {
+		cout << "Node " << i << " parent: " << parents[i] << endl;
+	}
+	cout << "Total weight: " << weight << endl;
+	
+	cout << "Running Prims Algorithm on an empty snapshot" << endl;
+	CsrGraph empty = Graph().Freeze();
+	empty.PrimsAlgorithm(forest);
+	empty.PrimsAlgorithm(parents);
+	cout << "Edges: " << forest.edges.size() << "\tParents: " << parents.size() << "\tNodes: " << empty.PrimsAlgorithm().size() << endl;
+	
+	cout << endl;
+	
+	cout << "Running Dijkstras Algorithm from node 1" << endl;
+	ShortestPathTree tree = csr.Dijkstra(1);
+	for (int i = 0; i < csr.GetNumVertices(); i++) {
+		cout << "Node " << i << " distance: " << tree.distances[i] << "\tparent: " << tree.parents[i] << endl;
+	}
+	
+	cout << "Running Dijkstras Algorithm from node 1 to 5 on the RadixHeap" << endl;
+	tree = csr.Dijkstra(1, 5, RadixHeapQueue);
+	vector<NodeID> path = tree.GetPath(5);
+	cout << "Distance: " << tree.distances[5] << "\tPath:";
+	for (int i = 0; i < path.size(); i++) {
+		cout << " " << path[i];
+	}
+	cout << endl;
+	
+	cout << "Is node 5 reachable from a node not in the graph? " << (csr.Dijkstra(10).Reached(5) ? "Yes" : "No") << endl;
+	
+	cout << "Running delta-stepping from node 1 with an automatic delta of " << csr.GetAutoDelta() << endl;
+	tree = csr.DeltaStepping(1);
+	cout << "Distances:";
+	for (int i = 0; i < csr.GetNumVertices(); i++) {
+		cout << " " << tree.distances[i];
+	}
+	cout << endl;
+	
+	cout << "Running a breadth first search from node 1" << endl;
+	BreadthFirstTree bfs = csr.BreadthFirstSearch(1);
+	cout << "Levels:";
+	for (int i = 0; i < csr.GetNumVertices(); i++) {
+		cout << " " << bfs.levels[i];
+	}
+	cout << endl;
+	
+	cout << "Labeling the connected components:";
+	vector<NodeID> labels = csr.ConnectedComponents();
+	for (int i = 0; i < labels.size(); i++) {
+		cout << " " << labels[i];
+	}
+	cout << endl;
+	
+	cout << "Transposing the snapshot, neighbors of node 3:";
+	CsrGraph transposed = csr.Transpose();
+	for (EdgeIndex i = transposed.GetBegin(3); i < transposed.GetEnd(3); i++) {
+		cout << " " << transposed.GetTarget(i);
+	}
+	cout << endl;
+	
+	cout << endl;
+	
+	cout << "Saving the snapshot to csr_test.graph... Successful?" << (csr.Save("csr_test.graph") ? " Yes" : " No") << endl;
+	
+	CsrGraph loaded;
+	cout << "Mapping the snapshot back in... Successful?" << (loaded.Load("csr_test.graph") ? " Yes" : " No") << endl;
+	cout << "Is the loaded graph mapped? " << (loaded.IsMapped() ? "Yes" : "No") << endl;
+	cout << "V: " << loaded.GetNumVertices() << "\t\tE: " << loaded.GetNumEdges() << endl;
+	loaded.Print();
+	
+	cout << "Loading a file that does not exist... Successful?" << (loaded.Load("missing.graph") ? " Yes" : " No") << endl;
+	cout << "V: " << loaded.GetNumVertices() << "\t\tE: " << loaded.GetNumEdges() << endl;
+	
+	// The position of the targets is the seventh field of the header
+	CsrGraph corrupt;
+	FILE * file = fopen("csr_test.graph", "r+b");
+	uint64_t targetsPos = 0;
+	NodeID outside = 1000000;
+	
+	fseek(file, 48, SEEK_SET);
+	fread(&targetsPos, sizeof(targetsPos), 1, file);
+	fseek(file, targetsPos, SEEK_SET);
+	fwrite(&outside, sizeof(outside), 1, file);
+	fclose(file);
+	
+	cout << "Loading a file with a target out of range and verifying it... Successful?" << (corrupt.Load("csr_test.graph", true) ? " Yes" : " No") << endl;
+	remove("csr_test.graph");
+	
+	cout << endl;
+	
+	return;
+}
+
+// TestGraphBuilderClass
+// Performs tests on all public GraphBuilder class functions
+void TestGraphBuilderClass() {
+	cout << " ---------- Testing the GraphBuilder class" << endl;
+	
+	cout << "Adding a batch of bidirectional edges, a duplicate (2, 0) and a self loop (4, 4)" << endl;
+	GraphBuilder builder;
+	builder.AddEdge(0, 1, 1);
+	builder.AddEdge(0, 2, 4);
+	builder.AddEdge(0, 3, 1);
+	builder.AddEdge(1, 4, 7);
+	builder.AddEdge(2, 3, 2);
+	builder.AddEdge(2, 4, 4);
+	builder.AddEdge(2, 5, 1);
+	builder.AddEdge(3, 4, 1);
+	builder.AddEdge(3, 5, 7);
+	builder.AddEdge(2, 0, 9);
+	builder.AddEdge(4, 4, 3);
+	
+	cout << "Building a Graph from the batch" << endl;
+	Graph g;
+	builder.Build(g);
+	cout << "V: " << g.GetNumVertices() << "\t\tE: " << g.GetNumEdges() << endl;
+	g.Print();
+	
+	cout << "Building into a graph maintaining its MSF keeps it maintained" << endl;
+	Graph maintained;
+	maintained.MaintainMST();
+	builder.Build(maintained);
+	cout << "Maintaining? " << (maintained.IsMaintainingMST() ? "Yes" : "No") << "\tMSF nodes: " << maintained.GetMST().size() << endl;
+	maintained.AddEdge(4, 5, -1);
+	for (int i = 0; i < maintained.GetMST().size(); i++) {
+		maintained.GetMST()[i].Print();
+		cout << endl;
+	}
+	
+	cout << "Building a CsrGraph from the batch" << endl;
+	CsrGraph csr = builder.BuildCsr();
+	cout << "V: " << csr.GetNumVertices() << "\t\tE: " << csr.GetNumEdges() << endl;
+	csr.Print();
+	
+	cout << "Building a random directed graph with 20000 nodes and 200000 edges both ways..." << endl;
+	GraphBuilder directed(true);
+	Graph bulk, single;
+	
+	for (int i = 0; i < 20000; i++) {
+		single.AddNode();
+	}
+	
+	directed.SetNumVertices(20000);
+	directed.Reserve(200000);
+	srand(1);
+	for (int i = 0; i < 200000; i++) {
+		NodeID s = rand() % 20000, e = rand() % 200;
+		
+		directed.AddEdge(s, e, i);
+		single.AddEdge(s, e, i, true);
+	}
+	
+	directed.Build(bulk);
+	cout << "Bulk V: " << bulk.GetNumVertices() << "\tE: " << bulk.GetNumEdges() << endl;
+	cout << "Single V: " << single.GetNumVertices() << "\tE: " << single.GetNumEdges() << endl;
+	
+	cout << endl;
+	
+	return;
+}
+
+// TestEdgeListReaderClass
+// Reads a small graph in every supported edge list format
+void TestEdgeListReaderClass() {
+	cout << " ---------- Testing the EdgeListReader class" << endl;
+	
+	EdgeListReader reader(2);
+	FILE * file;
+	
+	cout << "Reading a SNAP edge list with a comment, a missing weight and a bad line" << endl;
+	file = fopen("reader_test.txt", "w");
+	fputs("# Directed graph\n0\t1\t1.5\n0 2 4\n1 2\nnot an edge\n2 3 -2e1\n", file);
+	fclose(file);
+	
+	GraphBuilder snap(true);
+	cout << "Successful?" << (reader.Read("reader_test.txt", SnapFormat, snap) ? " Yes" : " No") << endl;
+	cout << "Skipped lines: " << reader.GetSkippedLines() << endl;
+	snap.BuildCsr().Print();
+	
+	cout << "Reading a DIMACS shortest path file" << endl;
+	file = fopen("reader_test.txt", "w");
+	fputs("c road graph\np sp 5 3\na 1 2 7\na 2 3 1\r\na 4 1 3\n", file);
+	fclose(file);
+	
+	GraphBuilder dimacs(true);
+	cout << "Successful?" << (reader.Read("reader_test.txt", DimacsFormat, dimacs) ? " Yes" : " No") << endl;
+	dimacs.BuildCsr().Print();
+	
+	cout << "Reading a symmetric MatrixMarket file" << endl;
+	file = fopen("reader_test.txt", "w");
+	fputs("%%MatrixMarket matrix coordinate real symmetric\n% comment\n4 4 3\n2 1 0.5\n3 1 2.25\n4 3 1\n", file);
+	fclose(file);
+	
+	GraphBuilder matrix(true);
+	cout << "Successful?" << (reader.Read("reader_test.txt", MatrixMarketFormat, matrix) ? " Yes" : " No") << endl;
+	matrix.BuildCsr().Print();
+	
+	cout << "Reading a skew-symmetric MatrixMarket file" << endl;
+	file = fopen("reader_test.txt", "w");
+	fputs("%%MatrixMarket matrix coordinate real skew-symmetric\n3 3 2\n2 1 0.5\n3 2 -4\n", file);
+	fclose(file);
+	
+	GraphBuilder skew(true), skewUndirected;
+	cout << "Successful?" << (reader.Read("reader_test.txt", MatrixMarketFormat, skew) ? " Yes" : " No") << endl;
+	skew.BuildCsr().Print();
+	cout << "Into an undirected builder... Successful?" << (reader.Read("reader_test.txt", MatrixMarketFormat, skewUndirected) ? " Yes" : " No") << endl;
+	
+	cout << "Reading a SNAP edge list as a MatrixMarket file... Successful?";
+	file = fopen("reader_test.txt", "w");
+	fputs("0 1\n", file);
+	fclose(file);
+	
+	GraphBuilder wrong;
+	cout << (reader.Read("reader_test.txt", MatrixMarketFormat, wrong) ? " Yes" : " No") << endl;
+	remove("reader_test.txt");
+	
+	cout << endl;
+	
+	return;
+}
+
+// TestIndexedHeapClass
+// Performs tests on all public IndexedHeap class functions
+void TestIndexedHeapClass() {
+	cout << " ---------- Testing the IndexedHeap class" << endl;
+	
+	IndexedHeap<float> heap(10, 3);
+	
+	cout << "Testing the Push function" << endl;
+	heap.Push(0, 40);
+	heap.Push(1, 60);
+	heap.Push(2, 30);
+	heap.Push(3, 50);
+	heap.Push(4, 70);
+	heap.Push(5, 45);
+	heap.Print();
+	
+	cout << "Pushing an ID that is already in the heap... Successful?" << (heap.Push(2, 1) ? " Yes" : " No") << endl;
+	
+	cout << endl << "Testing the DecreaseKey function (4 to 10)" << endl;
+	heap.DecreaseKey(4, 10);
+	heap.Print();
+	
+	cout << "Raising a key with DecreaseKey (4 to 90)... Successful?" << (heap.DecreaseKey(4, 90) ? " Yes" : " No") << endl;
+	
+	cout << "Testing the PushOrDecrease function (1 to 20, 7 at 35)" << endl;
+	heap.PushOrDecrease(1, 20);
+	heap.PushOrDecrease(7, 35);
+	heap.Print();
+	
+	cout << endl << "Popping every ID in order:";
+	while (!heap.Empty()) {
+		cout << " " << heap.Pop();
+	}
+	cout << endl;
+	
+	cout << "Heap size: " << heap.Size() << endl;
+	cout << "Does the heap contain 4? " << (heap.Contains(4) ? "Yes" : "No") << endl;
+	cout << endl;
+	
+	return;
+}
+
+// TestRadixHeapClass
+// Performs tests on all public RadixHeap class functions
+void TestRadixHeapClass() {
+	cout << " ---------- Testing the RadixHeap class" << endl;
+	
+	RadixHeap heap(10);
+	
+	cout << "Testing the Push function" << endl;
+	heap.Push(0, 40);
+	heap.Push(1, 60);
+	heap.Push(2, 30);
+	heap.Push(3, 50);
+	heap.Push(4, 70);
+	heap.Push(5, 45);
+	cout << "Heap size: " << heap.Size() << endl;
+	
+	cout << "Pushing an ID that is already in the heap... Successful?" << (heap.Push(2, 1) ? " Yes" : " No") << endl;
+	
+	cout << "Testing the DecreaseKey function (4 to 10)" << endl;
+	heap.DecreaseKey(4, 10);
+	cout << "Raising a key with DecreaseKey (4 to 90)... Successful?" << (heap.DecreaseKey(4, 90) ? " Yes" : " No") << endl;
+	
+	cout << "Popping the smallest ID: " << heap.Pop() << endl;
+	
+	cout << "Testing the PushOrDecrease function (1 to 20, 7 at 35)" << endl;
+	heap.PushOrDecrease(1, 20);
+	heap.PushOrDecrease(7, 35);
+	
+	cout << "Popping every ID in order:";
+	while (!heap.Empty()) {
+		int id = heap.Pop();
+		cout << " " << id << "(" << heap.GetKey(id) << ")";
+	}
+	cout << endl;
+	
+	cout << "Heap size: " << heap.Size() << endl;
+	cout << "Does the heap contain 4? " << (heap.Contains(4) ? "Yes" : "No") << endl;
+	cout << endl;
+	
+	return;
+}
+
+// TestEdgeArenaClass
+// Does tests on the public functions for the EdgeArena class and on graphs
+// placed in a region of our own
+void TestEdgeArenaClass() {
+	cout << " ---------- Testing the EdgeArena class" << endl;
+	
+	std::vector<char> region(4096);
+	EdgeArena arena;
+	
+	cout << "Placing the arena in a 4096 byte region... Successful?" << (arena.UseRegion(region.data(), region.size()) ? " Yes" : " No") << endl;
+	
+	cout << "Testing the Allocate function (24 bytes, then 100 bytes)" << endl;
+	char * first = (char *)arena.Allocate(24), * second = (char *)arena.Allocate(100);
+	cout << "Are both blocks in the region? " << (first >= region.data() && second + 100 <= region.data() + region.size() ? "Yes" : "No") << endl;
+	cout << "Bytes used: " << arena.GetUsedBytes() << endl;
+	
+	cout << "Moving the arena while it has blocks out... Successful?" << (arena.UseRegion(NULL, 0) ? " Yes" : " No") << endl;
+	
+	cout << "Testing the Deallocate function, the next 24 byte block reuses the first" << endl;
+	arena.Deallocate(first, 24);
+	cout << "Reused? " << (arena.Allocate(20) == first ? "Yes" : "No") << endl;
+	
+	cout << "Allocating past the end of the region carries on in chunks of its own" << endl;
+	char * outside = (char *)arena.Allocate(8192);
+	cout << "Is the block outside the region? " << (outside < region.data() || outside >= region.data() + region.size() ? "Yes" : "No") << endl;
+	
+	cout << "Testing the Release function" << endl;
+	arena.Release();
+	cout << "Bytes used: " << arena.GetUsedBytes() << endl;
+	cout << "Does the region get used again from its start? " << (arena.Allocate(16) == first ? "Yes" : "No") << endl;
+	
+	cout << "Building a graph in a region of its own" << endl;
+	Graph g;
+	std::vector<char> graphRegion(1 << 16);
+	
+	cout << "Placing the graph in the region... Successful?" << (g.UseRegion(graphRegion.data(), graphRegion.size()) ? " Yes" : " No") << endl;
+	for (int i = 0; i < 4; i++) {
+		g.AddNode();
+	}
+	g.AddEdge(0, 1, 3);
+	g.AddEdge(1, 2, 5);
+	g.AddEdge(2, 3, 1);
+	g.AddEdge(3, 0, 2, true);
+	cout << "Placing a graph with nodes... Successful?" << (g.UseRegion(NULL, 0) ? " Yes" : " No") << endl;
+	g.Print();
+	
+	cout << "Maintaining the MSF in the region too" << endl;
+	g.MaintainMST();
+	for (int i = 0; i < g.GetMST().size(); i++) {
+		g.GetMST()[i].Print();
+		cout << endl;
+	}
+	
+	cout << "Copying the graph, the copy has edges of its own" << endl;
+	Graph copy(g);
+	g.Clear();
+	copy.Print();
+	
+	cout << "Building again in the region after Clear" << endl;
+	g.AddNode();
+	g.AddNode();
+	g.AddEdge(0, 1, 7);
+	g.Print();
+	cout << endl;
+	
+	return;
+}
+
+// BenchmarkDeltaStepping
+// Times Dijkstra against delta-stepping on one thread and on every thread,
+// on a random graph and on a large diameter grid graph
+void BenchmarkDeltaStepping() {
+	cout << " ---------- Benchmarking DeltaStepping" << endl;
+	
+	for (int graph = 0; graph < 2; graph++) {
+		GraphBuilder builder;
+		std::chrono::steady_clock::time_point start;
+		double dijkstra, one, all;
+		
+		srand(42);
+		if (graph == 0) {
+			const int size = 1000000;
+			
+			cout << "Random graph, " << size << " nodes and " << 8 * size << " edges" << endl;
+			for (int i = 0; i < 8 * size; i++) {
+				builder.AddEdge(((long long)rand() * RAND_MAX + rand()) % size, ((long long)rand() * RAND_MAX + rand()) % size, rand() % 100 + 1);
+			}
+		} else {
+			const int side = 1000;
+			
+			cout << "Grid graph, " << side << " by " << side << " nodes" << endl;
+			for (int y = 0; y < side; y++) {
+				for (int x = 0; x < side; x++) {
+					if (x + 1 < side) {
+						builder.AddEdge(y * side + x, y * side + x + 1, rand() % 100 + 1);
+					}
+					
+					if (y + 1 < side) {
+						builder.AddEdge(y * side + x, (y + 1) * side + x, rand() % 100 + 1);
+					}
+				}
+			}
+		}
+		
+		CsrGraph csr = builder.BuildCsr();
+		
+		start = std::chrono::steady_clock::now();
+		ShortestPathTree expected = csr.Dijkstra(0);
+		dijkstra = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		
+		start = std::chrono::steady_clock::now();
+		csr.DeltaStepping(0, 0, 1);
+		one = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		
+		start = std::chrono::steady_clock::now();
+		ShortestPathTree found = csr.DeltaStepping(0);
+		all = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		
+		cout << "Dijkstra:\t\t\t" << dijkstra << "s" << endl;
+		cout << "DeltaStepping 1 thread:\t\t" << one << "s" << endl;
+		cout << "DeltaStepping " << GetNumThreads() << " threads:\t" << all << "s\tSpeedup: " << one / all << endl;
+		cout << "Same distances as Dijkstra? " << (found.distances == expected.distances ? "Yes" : "No") << endl;
+	}
+	
+	cout << endl;
+	
+	return;
+}
+
+// TestPathQueryClass
+// Performs tests on all public PathQuery class functions
+void TestPathQueryClass() {
+	cout << " ---------- Testing the PathQuery class" << endl;
+	
+	const int side = 10;
+	GraphBuilder builder;
+	
+	cout << "Building a " << side << " by " << side << " grid, edges to the right weigh 1 and edges down weigh 2" << endl;
+	for (int y = 0; y < side; y++) {
+		for (int x = 0; x < side; x++) {
+			if (x + 1 < side) {
+				builder.AddEdge(y * side + x, y * side + x + 1, 1);
+			}
+			
+			if (y + 1 < side) {
+				builder.AddEdge(y * side + x, (y + 1) * side + x, 2);
+			}
+		}
+	}
+	
+	CsrGraph csr = builder.BuildCsr();
+	PathQuery query(csr);
+	vector<NodeID> path;
+	
+	cout << "Bidirectional search from 0 to 99... Length: " << query.ShortestPath(0, 99, &path) << "\tHops: " << path.size() - 1 << endl;
+	cout << "Bidirectional search from 45 to 45... Length: " << query.ShortestPath(45, 45, &path) << "\tHops: " << path.size() - 1 << endl;
+	cout << "Bidirectional search from 0 to a node not in the graph... Length: " << query.ShortestPath(0, 100) << endl;
+	
+	// The straight line distance on the grid never overestimates
+	NodeID target = 99;
+	Weight length = query.AStar(0, target, [&](NodeID node) {
+		float dx = node % side - target % side, dy = 2 * (node / side - target / side);
+		return sqrtf(dx * dx + dy * dy);
+	}, &path);
+	
+	cout << "A* search from 0 to 99 with a straight line heuristic... Length: " << length << "\tPath:";
+	for (int i = 0; i < path.size(); i++) {
+		cout << " " << path[i];
+	}
+	cout << endl;
+	
+	cout << endl;
+	
+	return;
+}
+
+void TestContractionHierarchyClass() {
+	cout << " ---------- Testing the ContractionHierarchy class" << endl;
+	
+	const int side = 10;
+	GraphBuilder builder;
+	
+	cout << "Building a " << side << " by " << side << " grid, edges to the right weigh 1 and edges down weigh 2" << endl;
+	for (int y = 0; y < side; y++) {
+		for (int x = 0; x < side; x++) {
+			if (x + 1 < side) {
+				builder.AddEdge(y * side + x, y * side + x + 1, 1);
+			}
+			
+			if (y + 1 < side) {
+				builder.AddEdge(y * side + x, (y + 1) * side + x, 2);
+			}
+		}
+	}
+	
+	CsrGraph csr = builder.BuildCsr();
+	ContractionHierarchy hierarchy, loaded;
+	vector<NodeID> path;
+	
+	hierarchy.Build(csr);
+	cout << "Contracting the grid... Vertices: " << hierarchy.GetNumVertices() << "\tArcs: " << hierarchy.GetNumArcs() << endl;
+	
+	cout << "Query from 0 to 99... Length: " << hierarchy.Query(0, 99, &path) << "\tHops: " << path.size() - 1 << endl;
+	cout << "Query from 45 to 45... Length: " << hierarchy.Query(45, 45, &path) << "\tHops: " << path.size() - 1 << endl;
+	cout << "Query from 0 to a node not in the graph... Length: " << hierarchy.Query(0, 100) << endl;
+	
+	cout << "Query from 9 to 90 with the shortcuts unpacked... Length: " << hierarchy.Query(9, 90, &path) << "\tPath:";
+	for (int i = 0; i < path.size(); i++) {
+		cout << " " << path[i];
+	}
+	cout << endl;
+	
+	vector<NodeID> sources = { 0, 9, 90 }, targets = { 99, 0, 55, 100 };
+	vector<Weight> matrix(sources.size() * targets.size());
+	
+	hierarchy.DistanceMatrix(sources, targets, matrix.data());
+	cout << "Distance matrix from 0, 9 and 90 to 99, 0, 55 and a node not in the graph:" << endl;
+	for (int i = 0; i < sources.size(); i++) {
+		for (int j = 0; j < targets.size(); j++) {
+			cout << "\t" << matrix[i * targets.size() + j];
+		}
+		cout << endl;
+	}
+	
+	cout << "Saving the hierarchy to ch_test.graph... Successful?" << (hierarchy.Save("ch_test.graph") ? " Yes" : " No") << endl;
+	cout << "Loading the hierarchy back in... Successful?" << (loaded.Load("ch_test.graph") ? " Yes" : " No") << endl;
+	cout << "Query from 0 to 99 on the loaded hierarchy... Length: " << loaded.Query(0, 99) << endl;
+	cout << "Loading a file that does not exist... Successful?" << (loaded.Load("missing.graph") ? " Yes" : " No") << endl;
+	
+	// The first upward arc follows the header and the upward offsets
+	ContractionHierarchy corrupt;
+	FILE * file = fopen("ch_test.graph", "r+b");
+	uint64_t vertices = 0;
+	NodeID outside = 1000000;
+	
+	fseek(file, 24, SEEK_SET);
+	fread(&vertices, sizeof(vertices), 1, file);
+	fseek(file, 48 + sizeof(EdgeIndex) * (vertices + 1), SEEK_SET);
+	fwrite(&outside, sizeof(outside), 1, file);
+	fclose(file);
+	
+	cout << "Loading a file with an arc out of range... Successful?" << (corrupt.Load("ch_test.graph") ? " Yes" : " No") << endl;
+	
+	// A shortcut has to skip a node below both of its ends, so make the
+	// first upward arc skip its own target
+	struct {
+		NodeID target;
+		Weight weight;
+		NodeID middle;
+	} arc;
+	
+	hierarchy.Save("ch_test.graph");
+	file = fopen("ch_test.graph", "r+b");
+	fseek(file, 48 + sizeof(EdgeIndex) * (vertices + 1), SEEK_SET);
+	fread(&arc, sizeof(arc), 1, file);
+	arc.middle = arc.target;
+	fseek(file, 48 + sizeof(EdgeIndex) * (vertices + 1), SEEK_SET);
+	fwrite(&arc, sizeof(arc), 1, file);
+	fclose(file);
+	
+	cout << "Loading a file with a shortcut that skips its own end... Successful?" << (corrupt.Load("ch_test.graph") ? " Yes" : " No") << endl;
+	
+	remove("ch_test.graph");
+	
+	cout << endl;
+	
+	return;
+}